@@ -1,14 +1,38 @@
+#include <algorithm>
 #include <any>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <latch>
+#include <limits>
 #include <list>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <print>
+#include <random>
 #include <ranges>
 #include <set>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <tuple>
+#include <utility>
+#include <variant>
 #include <vector>
 
 // Patterns and Idioms
@@ -63,6 +87,86 @@ namespace n701
         }
     } // namespace
 
+    namespace
+    {
+        // With millions of units in one mixed container every unit->attack() is an indirect call whose target
+        // keeps changing, so the branch predictor misses a lot. Keeping one vector per concrete type lets us
+        // run every bucket in a tight loop. The qualified call u.T::attack() is not virtual, so it can be
+        // inlined.
+
+        template <typename... Ts>
+        class unit_buckets
+        {
+            std::tuple<std::vector<Ts>...> buckets_;
+
+          public:
+            template <typename T, typename... Args>
+            T &
+            emplace(Args &&...args)
+            {
+                return std::get<std::vector<T>>(buckets_).emplace_back(std::forward<Args>(args)...);
+            }
+
+            template <typename T>
+            std::vector<T> &
+            bucket()
+            {
+                return std::get<std::vector<T>>(buckets_);
+            }
+
+            template <typename T>
+            void
+            reserve(size_t const n)
+            {
+                bucket<T>().reserve(n);
+            }
+
+            size_t
+            size() const
+            {
+                return (std::get<std::vector<Ts>>(buckets_).size() + ... + 0);
+            }
+
+            void
+            clear()
+            {
+                (std::get<std::vector<Ts>>(buckets_).clear(), ...);
+            }
+
+            // f is called with every unit, bucket by bucket
+            template <typename F>
+            void
+            for_each(F &&f)
+            {
+                (std::ranges::for_each(std::get<std::vector<Ts>>(buckets_), f), ...);
+            }
+
+            void
+            attack()
+            {
+                (attack_bucket<Ts>(), ...);
+            }
+
+          private:
+            template <typename T>
+            void
+            attack_bucket()
+            {
+                for (auto &unit : std::get<std::vector<T>>(buckets_))
+                {
+                    unit.T::attack();
+                }
+            }
+        };
+
+        template <typename... Ts>
+        void
+        fight(unit_buckets<Ts...> &units)
+        {
+            units.attack();
+        }
+    } // namespace
+
     namespace
     {
         struct attack
@@ -224,36 +328,311 @@ namespace n704
         template <typename T, size_t N>
         struct limited_instances
         {
+            static constexpr size_t    capacity = N;
             static std::atomic<size_t> count; // every instantiation has its own static count!
 
             limited_instances()
             {
-                if (count >= N)
+                // Checking (count >= N) and then incrementing would be a race: two threads could both
+                // pass the check. compare_exchange reserves the slot only if count is still unchanged.
+                auto current = count.load(std::memory_order_relaxed);
+                do
                 {
-                    throw std::logic_error{"Too many instances"};
-                }
-                ++count;
+                    if (current >= N)
+                    {
+                        throw std::logic_error{"Too many instances"};
+                    }
+                } while (!count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed));
             }
 
+            // a copy is another instance
+            limited_instances(limited_instances const &) : limited_instances()
+            {
+            }
+
+            limited_instances &operator=(limited_instances const &) = default;
+
             ~limited_instances()
             {
-                --count;
+                count.fetch_sub(1, std::memory_order_relaxed);
             }
         };
 
         // init of non-const static data member
         template <typename T, size_t N>
         std::atomic<size_t> limited_instances<T, N>::count = 0;
+
+        // Same limit, but every thread caches up to Batch instance tokens. Tokens are reserved from the
+        // shared counter Batch at a time, so frequent construction/destruction mostly touches a
+        // thread_local counter instead of bouncing one cache line between all cores.
+        // Trade-off: tokens cached by one thread are not available to others, so a construction may
+        // fail although fewer than N instances are alive (never the other way round).
+        template <typename T, size_t N, size_t Batch = 8>
+        struct cached_limited_instances
+        {
+            static constexpr size_t    capacity = N;
+            static std::atomic<size_t> available; // tokens not held by any thread
+
+            cached_limited_instances()
+            {
+                if (cache.tokens == 0)
+                {
+                    cache.refill();
+                }
+                --cache.tokens;
+            }
+
+            cached_limited_instances(cached_limited_instances const &) : cached_limited_instances()
+            {
+            }
+
+            cached_limited_instances &operator=(cached_limited_instances const &) = default;
+
+            ~cached_limited_instances()
+            {
+                if (++cache.tokens > 2 * Batch)
+                {
+                    cache.give_back(Batch);
+                }
+            }
+
+          private:
+            struct token_cache
+            {
+                size_t tokens = 0;
+
+                void
+                refill()
+                {
+                    auto current = available.load(std::memory_order_relaxed);
+                    size_t take;
+                    do
+                    {
+                        if (current == 0)
+                        {
+                            throw std::logic_error{"Too many instances"};
+                        }
+                        take = std::min(current, Batch);
+                    } while (!available.compare_exchange_weak(current, current - take, std::memory_order_relaxed));
+                    tokens += take;
+                }
+
+                void
+                give_back(size_t const n) noexcept
+                {
+                    tokens -= n;
+                    available.fetch_add(n, std::memory_order_relaxed);
+                }
+
+                // a terminating thread returns its tokens
+                ~token_cache()
+                {
+                    give_back(tokens);
+                }
+            };
+
+            static inline thread_local token_cache cache;
+        };
+
+        template <typename T, size_t N, size_t Batch>
+        std::atomic<size_t> cached_limited_instances<T, N, Batch>::available = N;
+    } // namespace
+
+    namespace
+    {
+        // Since there are never more than T::capacity live instances, their storage can be preallocated.
+        // The class-level operator new/delete take and return slots of that storage in O(1) without
+        // touching the heap. With Cache > 0 every thread keeps up to Cache free slots, so most allocations
+        // don't need the lock.
+        // The pool doesn't enforce the limit, the constructor of T does: if no slot is free (all taken, or
+        // cached by other threads) the memory comes from the heap, so that the constructor gets to run and
+        // reports "Too many instances". Arrays are not pooled.
+        // T::capacity is only looked up inside member functions, when T is complete.
+        template <typename T, size_t Cache = 0>
+        struct instance_pool
+        {
+            static void *
+            operator new(size_t const size)
+            {
+                if (size != sizeof(T)) // a derived class bigger than T
+                {
+                    return ::operator new(size);
+                }
+                if (auto s = allocate())
+                {
+                    return s;
+                }
+                return ::operator new(size);
+            }
+
+            static void
+            operator delete(void *const p, size_t const size) noexcept
+            {
+                if (size != sizeof(T) || !pool().owns(p))
+                {
+                    ::operator delete(p, size);
+                    return;
+                }
+                deallocate(static_cast<slot *>(p));
+            }
+
+            static void *operator new[](size_t)                     = delete;
+            static void  operator delete[](void *, size_t) noexcept = delete;
+
+          private:
+            union slot
+            {
+                slot *next;
+                alignas(T) std::byte storage[sizeof(T)];
+            };
+
+            struct free_list
+            {
+                slot  *head = nullptr;
+                size_t size = 0;
+
+                void
+                push(slot *const s) noexcept
+                {
+                    s->next = head;
+                    head    = s;
+                    ++size;
+                }
+
+                slot *
+                pop() noexcept
+                {
+                    auto s = head;
+                    head   = s->next;
+                    --size;
+                    return s;
+                }
+
+                void
+                move_to(free_list &other, size_t n) noexcept
+                {
+                    for (n = std::min(n, size); n > 0; --n)
+                    {
+                        other.push(pop());
+                    }
+                }
+            };
+
+            struct slab
+            {
+                std::array<slot, T::capacity> slots;
+                std::mutex                    mutex;
+                free_list                     free;
+
+                slab()
+                {
+                    for (auto &s : slots | std::views::reverse)
+                    {
+                        free.push(&s);
+                    }
+                }
+
+                bool
+                owns(void const *const p) const noexcept
+                {
+                    std::less_equal<void const *> before;
+                    return before(&slots.front(), p) && before(p, &slots.back());
+                }
+            };
+
+            static slab &
+            pool()
+            {
+                static slab s;
+                return s;
+            }
+
+            // a terminating thread returns its cached slots
+            struct local_cache : free_list
+            {
+                ~local_cache()
+                {
+                    if (this->size > 0)
+                    {
+                        auto            &p = pool();
+                        std::lock_guard lock{p.mutex};
+                        this->move_to(p.free, this->size);
+                    }
+                }
+            };
+
+            static local_cache &
+            cache()
+            {
+                static thread_local local_cache c;
+                return c;
+            }
+
+            // nullptr if no slot is free
+            static slot *
+            allocate()
+            {
+                auto &p = pool();
+                if constexpr (Cache > 0)
+                {
+                    auto &local = cache();
+                    if (local.size == 0)
+                    {
+                        std::lock_guard lock{p.mutex};
+                        p.free.move_to(local, (Cache + 1) / 2);
+                    }
+                    if (local.size > 0)
+                    {
+                        return local.pop();
+                    }
+                }
+                else
+                {
+                    std::lock_guard lock{p.mutex};
+                    if (p.free.size > 0)
+                    {
+                        return p.free.pop();
+                    }
+                }
+                return nullptr;
+            }
+
+            static void
+            deallocate(slot *const s) noexcept
+            {
+                auto &p = pool();
+                if constexpr (Cache > 0)
+                {
+                    auto &local = cache();
+                    local.push(s);
+                    if (local.size > Cache)
+                    {
+                        std::lock_guard lock{p.mutex};
+                        local.move_to(p.free, local.size / 2);
+                    }
+                }
+                else
+                {
+                    std::lock_guard lock{p.mutex};
+                    p.free.push(s);
+                }
+            }
+        };
     } // namespace
 
     namespace
     {
-        struct excalibur : limited_instances<excalibur, 1>
+        struct excalibur : limited_instances<excalibur, 1>, instance_pool<excalibur>
+        {
+            // ...
+        };
+
+        struct book_of_magic : limited_instances<book_of_magic, 3>, instance_pool<book_of_magic>
         {
             // ...
         };
 
-        struct book_of_magic : limited_instances<book_of_magic, 3>
+        struct arrow : cached_limited_instances<arrow, 10'000>, instance_pool<arrow, 32>
         {
             // ...
         };
@@ -523,1232 +902,4745 @@ namespace n709b
     };
 } // namespace n709b
 
-namespace n709c
+namespace sbo
 {
-    // several tasks execute sth. on the same obj (in this case a building)
-
-    struct executor
+    // Small-buffer storage shared by the type-erasing wrappers below (n709c::unique_function, n712f::basic_unit,
+    // n712g::poly). An erased object of up to Capacity bytes lives inside the storage, a bigger one on the heap
+    // with its pointer in the storage. The wrapper describes its interface with a table of function pointers
+    // derived from lifetime (move-only) or copyable_lifetime - one static constexpr table per erased type.
+    // A moved-from storage is empty.
+
+    template <typename T, std::size_t Capacity>
+    inline constexpr bool stores_inline = sizeof(T) <= Capacity && alignof(T) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<T>;
+
+    // the erased object: in place, or behind the pointer in the storage
+    template <typename T, bool Heap, typename Void>
+    T &
+    object(Void *p) noexcept
     {
-        void
-        execute(std::function<void(void)> const &task)
+        if constexpr (Heap)
         {
-            threads.push_back(std::thread([task]() {
-                // using namespace std::chrono_literals;
-                // std::this_thread::sleep_for(250ms);
-
-                task();
-            }));
+            return **static_cast<std::remove_const_t<T> *const *>(p);
         }
-
-        ~executor()
+        else
         {
-            for (auto &t : threads)
+            return *static_cast<T *>(p);
+        }
+    }
+
+    struct lifetime
+    {
+        void (*relocate)(void *from, void *to) noexcept; // moves the object to `to` and ends it in `from`
+        void (*destroy)(void *) noexcept;
+    };
+
+    struct copyable_lifetime : lifetime
+    {
+        void (*copy)(void const *from, void *to);
+    };
+
+    template <typename T, bool Heap>
+    inline constexpr lifetime lifetime_of{
+        [](void *from, void *to) noexcept {
+            if constexpr (Heap)
             {
-                t.join();
+                ::new (to) T *(*static_cast<T **>(from));
             }
-        }
+            else
+            {
+                ::new (to) T(std::move(*static_cast<T *>(from)));
+                static_cast<T *>(from)->~T();
+            }
+        },
+        [](void *p) noexcept {
+            if constexpr (Heap)
+            {
+                delete *static_cast<T **>(p);
+            }
+            else
+            {
+                static_cast<T *>(p)->~T();
+            }
+        },
+    };
 
-      private:
-        std::vector<std::thread> threads;
+    template <typename T, bool Heap>
+    inline constexpr copyable_lifetime copyable_lifetime_of{
+        lifetime_of<T, Heap>,
+        [](void const *from, void *to) {
+            if constexpr (Heap)
+            {
+                ::new (to) T *(new T(object<T const, true>(from)));
+            }
+            else
+            {
+                ::new (to) T(object<T const, false>(from));
+            }
+        },
     };
 
-    struct building : std::enable_shared_from_this<building>
+    template <std::size_t Capacity, typename Table>
+        requires std::derived_from<Table, lifetime>
+    class storage
     {
-        building()
+      public:
+        template <typename T>
+        static constexpr bool on_heap = !stores_inline<T, Capacity>;
+
+        storage() noexcept = default;
+
+        storage(storage const &other)
+            requires std::derived_from<Table, copyable_lifetime>
         {
-            std::println("building created");
+            if (other.table_)
+            {
+                other.table_->copy(other.bytes_, bytes_);
+                table_ = other.table_;
+            }
         }
 
-        ~building()
+        storage(storage &&other) noexcept
         {
-            // will be called only once bc of shared_from_this
-            std::println("building destroyed");
+            take(other);
         }
 
-        void
-        upgrade()
+        storage &
+        operator=(storage const &other)
+            requires std::derived_from<Table, copyable_lifetime>
         {
-            if (exec)
+            if (this != &other)
             {
-                // exec->execute([self = this]()            { self->do_upgrade(); }); // This won't work!
+                storage copy{other}; // if copying throws, *this is unchanged
+                *this = std::move(copy);
+            }
+            return *this;
+        }
 
-                // another shared pointer to this building (the other one was created in main())
-                // -> keeps building alive
-                exec->execute([self = shared_from_this()]() { self->do_upgrade(); }); // OK!
+        storage &
+        operator=(storage &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                take(other);
             }
+            return *this;
         }
 
-        void
-        set_executor(executor *e)
+        ~storage()
         {
-            exec = e;
+            reset();
         }
 
-      private:
+        // ops is the table for T, built for on_heap<T>; the storage has to be empty
+        template <typename T, typename... A>
         void
-        do_upgrade()
+        emplace(Table const &ops, A &&...args)
         {
-            std::println("upgrading...");
-            operational = false;
-            std::println("upgraded");
-
-            // using namespace std::chrono_literals;
-            // std::this_thread::sleep_for(1000ms);
-
-            operational = true;
-            std::println("building is functional");
+            if constexpr (on_heap<T>)
+            {
+                ::new (static_cast<void *>(bytes_)) T *(new T(std::forward<A>(args)...));
+            }
+            else
+            {
+                ::new (static_cast<void *>(bytes_)) T(std::forward<A>(args)...);
+            }
+            table_ = &ops;
         }
 
-        bool      operational = false;
-        executor *exec        = nullptr;
-    };
-} // namespace n709c
-
-namespace n710b
-{
-    struct knight
-    {
         void
-        step_forth()
+        reset() noexcept
         {
-            std::println("knight moves forward");
+            if (table_)
+            {
+                table_->destroy(bytes_);
+                table_ = nullptr;
+            }
         }
 
-        void
-        step_back()
+        // nullptr if empty
+        Table const *
+        table() const noexcept
         {
-            std::println("knight moves back");
+            return table_;
         }
-    };
 
-    struct mage
-    {
-        void
-        step_forth()
+        void *
+        data() noexcept
         {
-            std::println("mage moves forward");
+            return bytes_;
         }
 
-        void
-        step_back()
+        void const *
+        data() const noexcept
         {
-            std::println("mage moves back");
+            return bytes_;
         }
-    };
 
-    // inherits from knight or mage (just the opposite what CRTP does)
-    template <typename T>
-    struct movable_unit : T
-    {
+      private:
         void
-        advance(size_t steps)
+        take(storage &other) noexcept
         {
-            while (steps--)
+            if (other.table_)
             {
-                T::step_forth();
+                other.table_->relocate(other.bytes_, bytes_);
+                table_ = std::exchange(other.table_, nullptr);
             }
         }
 
-        void
-        retreat(size_t steps)
-        {
-            while (steps--)
-            {
-                T::step_back();
-            }
-        }
+        alignas(std::max_align_t) std::byte bytes_[Capacity];
+        Table const *table_ = nullptr;
     };
-} // namespace n710b
+} // namespace sbo
 
-namespace n710a
+namespace n709c
 {
-    namespace
-    {
-        // Fighting strategies
-
-        struct hit_and_run
-        {
-            void
-            fight()
-            {
-                std::println("hit once hard then run");
-            }
-        };
-
-        struct last_man_standing
-        {
-            void
-            fight()
-            {
-                std::println("duel until one falls");
-            }
-        };
-    } // namespace
+    // several tasks execute sth. on the same obj (in this case a building)
 
-    // mixin adds functionality to a class by inheritance (not CRTP)
-    // a knight can fight
-    template <typename Strategy>
-    struct knight : public Strategy
+    // the original executor: one new thread per task (kept for comparison)
+    struct thread_per_task_executor
     {
         void
-        attack()
+        execute(std::function<void(void)> const &task)
         {
-            std::println("draw sword");
-            Strategy::fight();
+            threads.push_back(std::thread([task]() {
+                // using namespace std::chrono_literals;
+                // std::this_thread::sleep_for(250ms);
+
+                task();
+            }));
         }
-    };
 
-    // a mage can fight
-    template <typename Strategy>
-    struct mage : public Strategy
-    {
-        void
-        attack()
+        ~thread_per_task_executor()
         {
-            std::println("spell magic curse");
-            Strategy::fight();
+            for (auto &t : threads)
+            {
+                t.join();
+            }
         }
+
+      private:
+        std::vector<std::thread> threads;
     };
-} // namespace n710a
 
-namespace n710c
-{
-    // fighting styles
+    // Move-only replacement for std::function with inline (small buffer) storage.
+    // Callables that fit into Capacity bytes (e.g. a lambda capturing a shared_ptr) are stored
+    // in place - no heap allocation; larger ones fall back to the heap. Being move-only, captured
+    // shared_ptrs are moved along instead of copied (no atomic reference count bumps).
+    template <typename Signature, std::size_t Capacity = 48>
+    class unique_function;
 
-    struct aggressive_style
+    template <typename R, typename... Args, std::size_t Capacity>
+    class unique_function<R(Args...), Capacity>
     {
-        void
-        fight()
+      public:
+        unique_function() noexcept = default;
+
+        unique_function(std::nullptr_t) noexcept
         {
-            std::println("attack attack attack");
         }
-    };
 
-    struct moderate_style
-    {
-        void
-        fight()
+        template <typename F>
+            requires(!std::is_same_v<std::decay_t<F>, unique_function> &&
+                     std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+        unique_function(F &&f)
         {
-            std::println("attack then defend");
+            using D = std::decay_t<F>;
+            storage_.template emplace<D>(operations_for<D, storage_type::template on_heap<D>>, std::forward<F>(f));
         }
-    };
 
-    // type of warrior
+        unique_function(unique_function &&) noexcept            = default;
+        unique_function &operator=(unique_function &&) noexcept = default;
 
-    template <typename Fighting_Style>
-    struct lone_warrior : Fighting_Style
-    {
-        void
-        fight()
+        unique_function &
+        operator=(std::nullptr_t) noexcept
         {
-            std::println("fighting alone");
-            Fighting_Style::fight();
+            storage_.reset();
+            return *this;
         }
-    };
 
-    template <typename T>
-    struct team_warrior : T
-    {
-        void
-        fight()
+        unique_function(unique_function const &)            = delete;
+        unique_function &operator=(unique_function const &) = delete;
+
+        R
+        operator()(Args... args)
         {
-            std::println("fighting with a team");
-            T::fight();
+            return storage_.table()->invoke(storage_.data(), std::forward<Args>(args)...);
         }
-    };
-
-    // virtual class
-
-    struct game_unit
-    {
-        virtual void attack() = 0;
-        virtual ~game_unit()  = default;
-    };
 
-    template <typename Type_Warrior_or_Fighting_Style>
-    struct knight : Type_Warrior_or_Fighting_Style, game_unit
-    {
-        void
-        attack()
+        explicit
+        operator bool() const noexcept
         {
-            std::println("draw sword");
-            Type_Warrior_or_Fighting_Style::fight();
+            return storage_.table() != nullptr;
         }
-    };
 
-    template <typename T>
-    struct mage : T, game_unit
-    {
-        void
-        attack()
+        // true if a callable of type F is stored without heap allocation
+        template <typename F>
+        static constexpr bool
+        stores_inline()
         {
-            std::println("spell magic curse");
-            T::fight();
+            return sbo::stores_inline<F, Capacity>;
         }
+
+      private:
+        struct operations : sbo::lifetime
+        {
+            R (*invoke)(void *, Args &&...);
+        };
+
+        template <typename F, bool Heap>
+        static constexpr operations operations_for{
+            sbo::lifetime_of<F, Heap>,
+            [](void *p, Args &&...args) -> R {
+                return std::invoke_r<R>(sbo::object<F, Heap>(p), std::forward<Args>(args)...);
+            },
+        };
+
+        using storage_type = sbo::storage<Capacity, operations>;
+
+        storage_type storage_;
     };
-} // namespace n710c
 
-namespace n711a
-{
-    namespace details
+    // elements of an rvalue range are moved (tasks are move-only)
+    template <typename R>
+    using bulk_reference_t = std::conditional_t<std::is_lvalue_reference_v<R>, std::ranges::range_reference_t<R>,
+                                                std::ranges::range_rvalue_reference_t<R>>;
+
+    // Double-ended queue of tasks in a ring buffer. It only allocates when it has to grow, so
+    // pushing and popping tasks is allocation-free in the steady state.
+    // The owning worker pushes and pops at the back (LIFO, cache friendly), other workers steal
+    // from the front (FIFO, the oldest tasks).
+    template <typename Task>
+    struct work_queue
     {
-        template <typename Iter, typename Distance>
         void
-        advance(Iter &it, Distance n, std::random_access_iterator_tag)
+        push(Task task)
         {
-            it += n;
+            std::lock_guard lock{mutex_};
+            if (size_ == buffer_.size())
+            {
+                grow();
+            }
+            buffer_[(head_ + size_) & (buffer_.size() - 1)] = std::move(task);
+            ++size_;
         }
 
-        template <typename Iter, typename Distance>
+        // pushes all tasks under a single lock
+        template <std::ranges::sized_range R>
         void
-        advance(Iter &it, Distance n, std::bidirectional_iterator_tag)
+        push_bulk(R &&tasks)
         {
-            if (n > 0)
+            std::lock_guard lock{mutex_};
+            while (size_ + std::ranges::size(tasks) > buffer_.size())
             {
-                while (n--)
-                {
-                    ++it;
-                }
+                grow();
             }
-            else
+            for (auto &&task : tasks)
             {
-                while (n++)
-                {
-                    --it;
-                }
+                buffer_[(head_ + size_) & (buffer_.size() - 1)] = Task(std::forward<bulk_reference_t<R>>(task));
+                ++size_;
             }
         }
 
-        template <typename Iter, typename Distance>
-        void
-        advance(Iter &it, Distance n, std::input_iterator_tag)
+        bool
+        pop(Task &task)
         {
-            while (n--)
+            std::lock_guard lock{mutex_};
+            if (size_ == 0)
             {
-                ++it;
+                return false;
             }
+            --size_;
+            task = std::move(buffer_[(head_ + size_) & (buffer_.size() - 1)]);
+            return true;
         }
-    } // namespace details
-
-    template <typename Iter, typename Distance>
-    void
-    advance(Iter &it, Distance n)
-    {
-        details::advance(it, n, typename std::iterator_traits<Iter>::iterator_category{});
-    }
-} // namespace n711a
-
-namespace n711b
-{
-    template <std::random_access_iterator Iter, typename Distance>
-    void
-    advance(Iter &it, Distance n)
-    {
-        it += n;
-    }
 
-    template <std::bidirectional_iterator Iter, typename Distance>
-    void
-    advance(Iter &it, Distance n)
-    {
-        if (n > 0)
+        bool
+        steal(Task &task)
         {
-            while (n--)
+            std::lock_guard lock{mutex_};
+            if (size_ == 0)
             {
-                ++it;
+                return false;
             }
+            task  = std::move(buffer_[head_]);
+            head_ = (head_ + 1) & (buffer_.size() - 1);
+            --size_;
+            return true;
         }
-        else
+
+      private:
+        void
+        grow()
         {
-            while (n++)
+            std::vector<Task> bigger(std::max<std::size_t>(64, 2 * buffer_.size())); // power of two
+            for (std::size_t i = 0; i < size_; ++i)
             {
-                --it;
+                bigger[i] = std::move(buffer_[(head_ + i) & (buffer_.size() - 1)]);
             }
+            buffer_ = std::move(bigger);
+            head_   = 0;
         }
-    }
-
-    template <std::input_iterator Iter, typename Distance>
-    void
-    advance(Iter &it, Distance n)
-    {
-        while (n--)
-        {
-            ++it;
-        }
-    }
-} // namespace n711b
 
-namespace n712e
-{
-    // Classical C-style type erasure:
-    // basically this means using a lot of void* and reinterpret_casts! ;-)
+        std::mutex        mutex_;
+        std::vector<Task> buffer_;
+        std::size_t       head_ = 0;
+        std::size_t       size_ = 0;
+    };
 
-    namespace
+    // Fixed-size thread pool with one work queue per worker and work stealing.
+    // Tasks submitted from a worker go to its own queue, tasks from other threads are distributed
+    // round-robin. An idle worker steals from the others before it goes to sleep.
+    // The destructor waits until all tasks (including tasks submitted by tasks) have finished.
+    struct executor
     {
+        using task_type = unique_function<void(void)>;
 
-        struct knight
-        {
-            void
-            attack()
-            {
-                std::println("draw sword");
-            }
-        };
-
-        struct mage
+        explicit executor(std::size_t const threads = std::max(1u, std::thread::hardware_concurrency()))
+            : queues_(threads)
         {
-            void
-            attack()
+            workers_.reserve(threads);
+            for (std::size_t i = 0; i < threads; ++i)
             {
-                std::println("spell magic curse");
+                workers_.emplace_back([this, i]() { work(i); });
             }
-        };
-    } // namespace
+        }
 
-    namespace
-    {
-        // all types erased; only void pointers
+        executor(executor const &)            = delete;
+        executor &operator=(executor const &) = delete;
 
         void
-        fight_knight(void *k)
+        execute(task_type task)
         {
-            reinterpret_cast<knight *>(k)->attack();
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            queued_.fetch_add(1, std::memory_order_release);
+
+            auto const index = current_ == this ? current_index_
+                                                : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+            queues_[index].push(std::move(task));
+
+            queued_.notify_one();
         }
 
+        // Enqueues a whole batch with one lock and one atomic update per counter.
+        // The batch goes to a single queue; idle workers steal from it.
+        template <std::ranges::sized_range R>
+            requires std::constructible_from<task_type, bulk_reference_t<R>>
         void
-        fight_mage(void *m)
+        execute_bulk(R &&tasks)
         {
-            reinterpret_cast<mage *>(m)->attack();
-        }
+            auto const n = static_cast<std::size_t>(std::ranges::size(tasks));
+            if (n == 0)
+            {
+                return;
+            }
 
-        using fight_fn                  = void (*)(void *);
-        using mapping_void_ptr_fight_fn = std::pair<void *, fight_fn>;
+            pending_.fetch_add(n, std::memory_order_relaxed);
+            queued_.fetch_add(n, std::memory_order_release);
 
-        void
-        fight(std::vector<mapping_void_ptr_fight_fn> const &units)
+            auto const index = current_ == this ? current_index_
+                                                : next_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+            queues_[index].push_bulk(std::forward<R>(tasks));
+
+            queued_.notify_all();
+        }
+
+        std::size_t
+        size() const noexcept
         {
-            for (auto &unit : units)
+            return workers_.size();
+        }
+
+        ~executor()
+        {
+            for (auto n = pending_.load(); n != 0; n = pending_.load())
             {
-                unit.second(unit.first);
+                pending_.wait(n);
             }
-        }
-    } // namespace
-} // namespace n712e
 
-namespace n712a
-{
-    // Type erasure using polymorphism and inheritance.
+            stop_ = true;
+            queued_.fetch_add(1); // wake up the sleeping workers
+            queued_.notify_all();
 
-    namespace
-    {
-        struct knight
-        {
-            void
-            attack()
+            for (auto &t : workers_)
             {
-                std::println("draw sword");
+                t.join();
             }
-        };
+        }
 
-        struct mage
+      private:
+        friend struct task_group;
+
+        // lets a worker that waits for other tasks help instead of blocking
+        bool
+        try_run_one()
         {
-            void
-            attack()
+            task_type task;
+            if (current_ != this || !try_get(current_index_, task))
             {
-                std::println("spell magic curse");
+                return false;
             }
-        };
-    } // namespace
+            run(task);
+            return true;
+        }
 
-    namespace
-    {
-        struct game_unit
+        void
+        run(task_type &task)
         {
-            virtual void attack() = 0;
-            virtual ~game_unit()  = default;
-        };
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            task = nullptr;
 
-        struct knight_unit : game_unit
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                pending_.notify_all();
+            }
+        }
+
+        bool
+        try_get(std::size_t const index, task_type &task)
         {
-            knight_unit(knight &u) : k(u)
+            if (queues_[index].pop(task))
             {
+                return true;
             }
 
-            void
-            attack() override
+            for (std::size_t k = 1; k < queues_.size(); ++k)
             {
-                k.attack();
+                if (queues_[(index + k) % queues_.size()].steal(task))
+                {
+                    return true;
+                }
             }
 
-          private:
-            knight &k;
-        };
+            return false;
+        }
 
-        struct mage_unit : game_unit
+        void
+        work(std::size_t const index)
         {
-            mage_unit(mage &u) : m(u)
-            {
-            }
+            current_       = this;
+            current_index_ = index;
 
-            void
-            attack() override
+            task_type task;
+            while (!stop_)
             {
-                m.attack();
+                if (try_get(index, task))
+                {
+                    run(task);
+                }
+                else
+                {
+                    queued_.wait(0, std::memory_order_acquire); // sleep until something was queued
+                }
             }
+        }
 
-          private:
-            mage &m;
-        };
-    } // namespace
+        std::vector<work_queue<task_type>> queues_;
+        std::vector<std::thread>           workers_;
+        std::atomic<std::size_t>           next_{0};    // round-robin for external submissions
+        std::atomic<std::size_t>           queued_{0};  // tasks waiting in the queues
+        std::atomic<std::size_t>           pending_{0}; // tasks not finished yet
+        std::atomic<bool>                  stop_{false};
 
-    // It can be argued that types have not been completely erased.
-    // Both knight and mage are game_unit and the fight function handles
-    // anything that is a game_unit.
-    void
-    fight(std::vector<game_unit *> const &units) // knight and mage types erased
+        static inline thread_local executor   *current_       = nullptr;
+        static inline thread_local std::size_t current_index_ = 0;
+    };
+
+    // Waits for a subset of the tasks of an executor (the executor itself keeps running).
+    // run() returns a std::future for the result of the callable.
+    struct task_group
     {
-        for (auto u : units)
+        explicit task_group(executor &e) : exec_(e)
         {
-            u->attack();
         }
-    }
-} // namespace n712a
 
-namespace n712b
-{
-    // removing code duplication using templates
+        task_group(task_group const &)            = delete;
+        task_group &operator=(task_group const &) = delete;
 
-    namespace
-    {
-        struct knight
+        ~task_group()
         {
-            void
-            attack()
-            {
-                std::println("draw sword");
-            }
-        };
+            wait();
+        }
 
-        struct mage
+        template <typename F>
+        auto
+        run(F &&f) -> std::future<std::invoke_result_t<std::decay_t<F> &>>
         {
-            void
-            attack()
-            {
-                std::println("spell magic curse");
-            }
-        };
-    } // namespace
+            // a packaged_task is move-only; it fits into executor::task_type, but not into std::function
+            std::packaged_task<std::invoke_result_t<std::decay_t<F> &>()> work{std::forward<F>(f)};
+            auto result = work.get_future();
 
-    struct game_unit
-    {
-        virtual void attack() = 0;
-        virtual ~game_unit()  = default;
-    };
+            outstanding_.fetch_add(1, std::memory_order_relaxed);
+            exec_.execute([this, work = std::move(work)]() mutable {
+                work();
+                done();
+            });
 
-    // all types have been erased
-    template <typename T>
-    struct game_unit_wrapper : public game_unit
-    {
-        game_unit_wrapper(T &unit) : t(unit)
+            return result;
+        }
+
+        // all callables of the range are submitted with executor::execute_bulk;
+        // each task owns its callable: copied from an lvalue range, moved from an rvalue range
+        template <std::ranges::sized_range R>
+        void
+        run_bulk(R &&callables)
         {
+            using callable_type = std::ranges::range_value_t<R>;
+
+            outstanding_.fetch_add(std::ranges::size(callables), std::memory_order_relaxed);
+            exec_.execute_bulk(callables | std::views::transform([this](auto &&f) -> executor::task_type {
+                                   return [this, f = callable_type(std::forward<bulk_reference_t<R>>(f))]() mutable {
+                                       f();
+                                       done();
+                                   };
+                               }));
         }
 
+        // blocks until all tasks of the group have finished; a worker thread helps out meanwhile
         void
-        attack() override
+        wait()
         {
-            t.attack();
+            for (auto n = outstanding_.load(std::memory_order_acquire); n != 0;
+                 n      = outstanding_.load(std::memory_order_acquire))
+            {
+                if (!exec_.try_run_one())
+                {
+                    outstanding_.wait(n, std::memory_order_acquire);
+                }
+            }
         }
 
       private:
-        T &t;
+        void
+        done()
+        {
+            if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                outstanding_.notify_all();
+            }
+        }
+
+        executor                &exec_;
+        std::atomic<std::size_t> outstanding_{0};
     };
 
-    void
-    fight(std::vector<game_unit *> const &units)
+    struct building : std::enable_shared_from_this<building>
     {
-        for (auto u : units)
+        building()
         {
-            u->attack();
+            std::println("building created");
         }
-    }
-} // namespace n712b
-
-namespace n712c
-{
-    // Putting concept and model in a common class.
-    struct game
-    {
-        // In the type erasure pattern, the abstract base class is called
-        // a CONCEPT and the wrapper that inherits from it is called a MODEL.
 
-        // CONCEPT (the interface)
-        // everything is declared in terms of this concept (all types erased)
-        // duck typing: anything that can attack is a gameu_unit
-        // defines what a game_unit is (anything that can attack)
-        struct game_unit
+        ~building()
         {
-            virtual void attack() = 0;
-            virtual ~game_unit()  = default;
-        };
+            // will be called only once bc of shared_from_this
+            std::println("building destroyed");
+        }
 
-        // MODEL (the implementation; inherits from concept)
-        template <typename T>
-        struct game_unit_wrapper : public game_unit
+        void
+        upgrade()
         {
-            game_unit_wrapper(T &unit) : t(unit)
+            if (exec)
             {
-            }
+                // exec->execute([self = this]()            { self->do_upgrade(); }); // This won't work!
 
-            void
-            attack() override
-            {
-                t.attack(); // just forward attack()
+                // another shared pointer to this building (the other one was created in main())
+                // -> keeps building alive
+                exec->execute([self = shared_from_this()]() { self->do_upgrade(); }); // OK!
             }
+        }
 
-          private:
-            T &t;           // wrapper around this
-        };
-
-        // API
-
-        template <typename T>
+        // upgrade as part of a group, so that the caller can wait for just these upgrades
         void
-        addUnit(T &unit)
+        upgrade(task_group &group)
         {
-            // using the copy constructor of game_unit_wrapper and unit
-            units.push_back(std::make_unique<game_unit_wrapper<T>>(unit));
+            group.run([self = shared_from_this()]() { self->do_upgrade(); });
         }
 
         void
-        fight()
+        set_executor(executor *e)
         {
-            for (auto &u : units)
-            {
-                u->attack();
-            }
+            exec = e;
         }
 
       private:
-        std::vector<std::unique_ptr<game_unit>> units;
+        void
+        do_upgrade()
+        {
+            std::println("upgrading...");
+            operational = false;
+            std::println("upgraded");
+
+            // using namespace std::chrono_literals;
+            // std::this_thread::sleep_for(1000ms);
+
+            operational = true;
+            std::println("building is functional");
+        }
+
+        bool      operational = false;
+        executor *exec        = nullptr;
     };
+} // namespace n709c
 
-    namespace
-    {
-        // knight and mage are game_units because they can attack()
+namespace n709d
+{
+    // Coroutine based upgrades: upgrade() returns an awaitable task. A suspended upgrade does not
+    // occupy a thread, so thousands of buildings can be upgraded concurrently on a few executor
+    // threads. Delays are suspension points served by a timer wheel instead of blocking sleeps.
 
-        struct knight
+    namespace detail
+    {
+        template <typename T>
+        struct task_result
         {
             void
-            attack()
+            return_value(T value)
             {
-                std::println("draw sword");
+                value_ = std::move(value);
+            }
+
+            T
+            result()
+            {
+                if (exception_)
+                {
+                    std::rethrow_exception(exception_);
+                }
+                return std::move(*value_);
+            }
+
+            void
+            unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
             }
+
+          private:
+            std::optional<T>   value_;
+            std::exception_ptr exception_;
         };
 
-        struct mage
+        template <>
+        struct task_result<void>
         {
             void
-            attack()
+            return_void() noexcept
             {
-                std::println("spell magic curse");
             }
-        };
-    } // namespace
 
-} // namespace n712c
-
-namespace n712d
-{
-    // General pattern
-
-    struct unit
-    {
-        // API
-
-        // template constructor that enables us to create model objects from, e.g. knight and mage objects.
-        template <typename T>
-        unit(T &&obj) : unit_(std::make_shared<unit_model<T>>(std::forward<T>(obj)))
-        {
-        }
-
-        void
-        attack()
-        {
-            unit_->attack();
-        }
-
-        // concept
-        struct unit_concept
-        {
-            virtual void attack()   = 0;
-            virtual ~unit_concept() = default;
-        };
-
-        // model (inherits from concept)
-        template <typename T>
-        struct unit_model : public unit_concept
-        {
-            unit_model(T &unit) : t(unit)
-            {
-            }
+            void
+            result()
+            {
+                if (exception_)
+                {
+                    std::rethrow_exception(exception_);
+                }
+            }
 
             void
-            attack() override
+            unhandled_exception() noexcept
             {
-                t.attack();                  // forward attack()
+                exception_ = std::current_exception();
             }
 
           private:
-            T &t;                            // unit_model is just a wrapper around a T
+            std::exception_ptr exception_;
         };
+    } // namespace detail
 
-      private:
-        std::shared_ptr<unit_concept> unit_; // a unit is a wrapper around a concept
-    };
-
-    namespace
+    // Lazy task: starts when it is awaited and resumes the awaiting coroutine when it is done.
+    template <typename T = void>
+    struct [[nodiscard]] task
     {
-        struct knight
+        struct promise_type : detail::task_result<T>
         {
-            void
-            attack()
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+
+            task
+            get_return_object() noexcept
             {
-                std::println("draw sword");
+                return task{std::coroutine_handle<promise_type>::from_promise(*this)};
             }
-        };
 
-        struct mage
-        {
-            void
-            attack()
+            std::suspend_always
+            initial_suspend() noexcept
             {
-                std::println("spell magic curse");
+                return {};
             }
-        };
-    } // namespace
 
-    // defined in terms of units (type erased)
-    void
-    fight(std::vector<unit> &units)
-    {
-        for (auto &u : units)
-        {
-            u.attack();
-        }
-    }
-} // namespace n712d
+            struct final_awaiter
+            {
+                bool
+                await_ready() noexcept
+                {
+                    return false;
+                }
 
-namespace n713
-{
-    class async_bool
-    {
-        std::function<bool()> check;
+                // symmetric transfer: resume whoever awaited us
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                {
+                    return h.promise().continuation;
+                }
 
-      public:
-        async_bool() = delete;
+                void
+                await_resume() noexcept
+                {
+                }
+            };
 
-        async_bool(std::function<bool()> checkIt) : check(checkIt)
-        {
-        }
+            final_awaiter
+            final_suspend() noexcept
+            {
+                return {};
+            }
+        };
 
-        async_bool(bool val) : check([val] { return val; })
+        task(task &&other) noexcept : handle_(std::exchange(other.handle_, {}))
         {
         }
 
-        static async_bool
-        yes()
+        task &
+        operator=(task &&other) noexcept
         {
-            return async_bool{[] { return true; }()};
+            if (this != &other)
+            {
+                if (handle_)
+                {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
         }
 
-        static async_bool
-        no()
+        ~task()
         {
-            return async_bool{[] { return false; }()};
+            if (handle_)
+            {
+                handle_.destroy();
+            }
         }
 
         bool
-        operator&&(bool fore) const
+        await_ready() const noexcept
         {
-            return fore && check();
+            return false;
         }
-        bool
-        operator!() const
+
+        std::coroutine_handle<>
+        await_suspend(std::coroutine_handle<> awaiting) noexcept
         {
-            return !check();
+            handle_.promise().continuation = awaiting;
+            return handle_;
         }
-        operator bool() const
+
+        T
+        await_resume()
         {
-            return check();
+            return handle_.promise().result();
         }
-    };
-} // namespace n713
 
-// Typelists
-//
-// Today, perhaps many of the problems for which typelists represented the solution
-// can be also solved using variadic templates.
+      private:
+        explicit task(std::coroutine_handle<promise_type> h) : handle_(h)
+        {
+        }
 
-namespace n714
-{
-    template <typename... Ts>
-    struct typelist
-    {
+        std::coroutine_handle<promise_type> handle_;
     };
 
-    struct empty_type
+    // Hashed timer wheel: a timer lands in slot (now + ticks) % slots and fires when the wheel
+    // has turned `rounds` more times. Scheduling and expiring a timer are O(1).
+    // Expired coroutines are resumed on the executor, not on the ticking thread.
+    // Timers still pending when the wheel is destroyed are cancelled: their coroutines are resumed with the
+    // cancelled flag set (instead of leaking suspended frames), and timers scheduled afterwards are refused.
+    struct timer_wheel
     {
-    };
+        using clock = std::chrono::steady_clock;
 
-    // typical namespace name for implementation details
-    namespace detail
-    {
-        // length
+        explicit timer_wheel(n709c::executor &e, clock::duration const tick = std::chrono::milliseconds{1},
+                             std::size_t const slots = 256)
+            : exec_(e), tick_(tick), slots_(slots), ticker_([this](std::stop_token stop) { run(stop); })
+        {
+        }
 
-        template <typename TL>
-        struct length;
+        timer_wheel(timer_wheel const &)            = delete;
+        timer_wheel &operator=(timer_wheel const &) = delete;
 
-        template <template <typename...> typename TL, typename... Ts>
-        struct length<TL<Ts...>>
+        ~timer_wheel()
         {
-            using type = std::integral_constant<std::size_t, sizeof...(Ts)>;
-        };
+            ticker_.request_stop();
+            ticker_.join();
 
-        // front_type
+            std::vector<entry> pending;
+            {
+                std::lock_guard lock{mutex_};
+                stopped_ = true;
+                for (auto &slot : slots_)
+                {
+                    pending.insert(pending.end(), slot.begin(), slot.end());
+                    slot.clear();
+                }
+            }
 
-        template <typename TL>
-        struct front_type;
+            // resumed right here: the executor might already be busy shutting down
+            for (auto &e : pending)
+            {
+                *e.cancelled = true;
+                e.handle.resume();
+            }
+        }
 
-        template <template <typename...> typename TL, typename T, typename... Ts>
-        struct front_type<TL<T, Ts...>>
+        // false if the wheel is shutting down; h is not suspended then
+        bool
+        schedule(clock::duration const delay, std::coroutine_handle<> h, bool &cancelled)
         {
-            using type = T;
-        };
+            auto const rounded_up = (delay + tick_ - clock::duration{1}) / tick_;
+            auto const ticks      = std::max<std::size_t>(1, static_cast<std::size_t>(rounded_up));
 
-        template <template <typename...> typename TL>
-        struct front_type<TL<>>
+            std::lock_guard lock{mutex_};
+            if (stopped_)
+            {
+                cancelled = true;
+                return false;
+            }
+            slots_[(current_ + ticks) % slots_.size()].push_back({(ticks - 1) / slots_.size(), h, &cancelled});
+            return true;
+        }
+
+      private:
+        struct entry
         {
-            using type = empty_type;
+            std::size_t             rounds;
+            std::coroutine_handle<> handle;
+            bool                   *cancelled;
         };
 
-        // back_type
+        void
+        run(std::stop_token const &stop)
+        {
+            auto next = clock::now();
+            while (!stop.stop_requested())
+            {
+                next += tick_;
+                std::this_thread::sleep_until(next);
+
+                std::lock_guard lock{mutex_};
+                current_    = (current_ + 1) % slots_.size();
+                auto &slot  = slots_[current_];
+                auto  first = std::partition(slot.begin(), slot.end(), [](entry const &e) { return e.rounds != 0; });
+                for (auto it = slot.begin(); it != first; ++it)
+                {
+                    --it->rounds; // one more turn to go
+                }
+                for (auto it = first; it != slot.end(); ++it)
+                {
+                    exec_.execute([h = it->handle]() { h.resume(); });
+                }
+                slot.erase(first, slot.end());
+            }
+        }
 
-        template <typename TL>
-        struct back_type;
+        n709c::executor                &exec_;
+        clock::duration                 tick_;
+        std::vector<std::vector<entry>> slots_;
+        std::size_t                     current_ = 0;
+        bool                            stopped_ = false;
+        std::mutex                      mutex_;
+        std::jthread                    ticker_; // last member: starts after everything else is initialized
+    };
 
-        template <template <typename...> typename TL, typename T, typename... Ts>
-        struct back_type<TL<T, Ts...>>
+    struct scheduler
+    {
+        explicit scheduler(n709c::executor &e) : exec_(e), timers_(e)
         {
-            using type = back_type<TL<Ts...>>::type;
-        };
+        }
 
-        template <template <typename...> typename TL, typename T>
-        struct back_type<TL<T>>
+        // co_await schedule(): continue on an executor thread
+        auto
+        schedule()
         {
-            using type = T;
-        };
+            struct awaiter
+            {
+                n709c::executor &exec;
 
-        template <template <typename...> typename TL>
-        struct back_type<TL<>>
-        {
-            using type = empty_type;
-        };
+                bool
+                await_ready() const noexcept
+                {
+                    return false;
+                }
 
-        // push_back
+                void
+                await_suspend(std::coroutine_handle<> h)
+                {
+                    exec.execute([h]() { h.resume(); });
+                }
 
-        template <typename TL, typename T>
-        struct push_back_type;
+                void
+                await_resume() const noexcept
+                {
+                }
+            };
 
-        template <template <typename...> typename TL, typename T, typename... Ts>
-        struct push_back_type<TL<Ts...>, T>
+            return awaiter{exec_};
+        }
+
+        // co_await sleep_for(d): suspend (without blocking a thread) for at least d;
+        // throws if the scheduler is destroyed before the time is up
+        auto
+        sleep_for(timer_wheel::clock::duration const d)
         {
-            using type = TL<Ts..., T>;
-        };
+            struct awaiter
+            {
+                timer_wheel                 &timers;
+                timer_wheel::clock::duration delay;
+                bool                         cancelled = false;
 
-        // push_front
+                bool
+                await_ready() const noexcept
+                {
+                    return delay <= timer_wheel::clock::duration::zero();
+                }
 
-        template <typename TL, typename T>
-        struct push_front_type;
+                bool
+                await_suspend(std::coroutine_handle<> h)
+                {
+                    return timers.schedule(delay, h, cancelled);
+                }
 
-        template <template <typename...> typename TL, typename T, typename... Ts>
-        struct push_front_type<TL<Ts...>, T>
-        {
-            using type = TL<T, Ts...>;
-        };
+                void
+                await_resume() const
+                {
+                    if (cancelled)
+                    {
+                        throw std::runtime_error{"timer wheel shut down"};
+                    }
+                }
+            };
 
-        // pop_front
+            return awaiter{timers_, d};
+        }
 
-        template <typename TL>
-        struct pop_front_type;
+      private:
+        n709c::executor &exec_;
+        timer_wheel      timers_;
+    };
 
-        template <template <typename...> typename TL, typename T, typename... Ts>
-        struct pop_front_type<TL<T, Ts...>>
+    namespace detail
+    {
+        struct detached
         {
-            using type = TL<Ts...>;
-        };
+            struct promise_type
+            {
+                detached
+                get_return_object() noexcept
+                {
+                    return {};
+                }
 
-        template <template <typename...> typename TL>
-        struct pop_front_type<TL<>>
-        {
-            using type = TL<>;
-        };
+                std::suspend_never
+                initial_suspend() noexcept
+                {
+                    return {};
+                }
 
-        // pop_back
+                std::suspend_never
+                final_suspend() noexcept
+                {
+                    return {};
+                }
 
-        template <std::ptrdiff_t N, typename R, typename TL>
-        struct pop_back_type;
+                void
+                return_void() noexcept
+                {
+                }
 
-        template <std::ptrdiff_t N, typename... Ts, typename U, typename... Us>
-        struct pop_back_type<N, typelist<Ts...>, typelist<U, Us...>>
-        {
-            using type = typename pop_back_type<N - 1, typelist<Ts..., U>, typelist<Us...>>::type;
+                void
+                unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
         };
 
-        template <typename... Ts, typename U, typename... Us>
-        struct pop_back_type<0, typelist<Ts...>, typelist<U, Us...>>
+        template <typename T>
+        detached
+        run_and_count_down(task<T> t, std::optional<T> &result, std::exception_ptr &error, std::latch &done)
         {
-            using type = typelist<Ts...>;
-        };
+            try
+            {
+                result.emplace(co_await t);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            done.count_down();
+        }
 
-        template <>
-        struct pop_back_type</***/ -1, typelist<>, typelist<>>
+        inline detached
+        run_and_count_down(task<> t, std::exception_ptr &error, std::latch &done)
         {
-            using type = typelist<>;
-        };
-
-        // at
+            try
+            {
+                co_await t;
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            done.count_down();
+        }
+    } // namespace detail
 
-        template <std::size_t I, std::size_t N, typename TL>
-        struct at_type;
+    // blocks the calling (non-executor) thread until the task has finished
+    template <typename T>
+    T
+    sync_wait(task<T> t)
+    {
+        std::latch         done{1};
+        std::exception_ptr error;
 
-        // counting N up to I
-        template <std::size_t I, std::size_t N, template <typename...> typename TL, typename T, typename... Ts>
-        struct at_type<I, N, TL<T, Ts...>>
+        if constexpr (std::is_void_v<T>)
         {
-            using type = std::conditional_t<I == N, T, typename at_type<I, N + 1, TL<Ts...>>::type>;
-        };
+            detail::run_and_count_down(std::move(t), error, done);
+            done.wait();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+        else
+        {
+            std::optional<T> result;
+            detail::run_and_count_down(std::move(t), result, error, done);
+            done.wait();
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            return std::move(*result);
+        }
+    }
 
-        // wrong index
-        template <std::size_t I, std::size_t N>
-        struct at_type<I, N, typelist<>>
+    // starts all tasks concurrently and blocks until every one of them has finished
+    inline void
+    sync_wait_all(std::vector<task<>> tasks)
+    {
+        std::latch                      done{static_cast<std::ptrdiff_t>(tasks.size())};
+        std::vector<std::exception_ptr> errors(tasks.size());
+
+        for (std::size_t i = 0; i < tasks.size(); ++i)
         {
-            using type = empty_type;
-        };
-    } // namespace detail
+            detail::run_and_count_down(std::move(tasks[i]), errors[i], done);
+        }
+        done.wait();
 
-    // length_t
+        for (auto const &error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    }
 
-    template <typename TL>
-    using length_t = detail::length<TL>::type; // is an integral_constant
+    struct building
+    {
+        explicit building(scheduler &s) : sched_(s)
+        {
+        }
 
-    static_assert(length_t<typelist<int, double, char>>::value == 3);
+        // The caller keeps the building alive until the returned task has completed
+        // (it owns and awaits the task), so no shared_from_this() is needed here.
+        task<>
+        upgrade()
+        {
+            co_await sched_.schedule(); // continue on an executor thread
 
-    // length_v
+            operational_ = false;
 
-    template <typename TL>
-    inline constexpr std::size_t length_v = length_t<TL>::value;
+            using namespace std::chrono_literals;
+            co_await sched_.sleep_for(250ms); // suspension point instead of std::this_thread::sleep_for
 
-    static_assert(length_v<typelist<int, double, char>> == 3);
-    static_assert(length_v<typelist<int, double>> == 2);
-    static_assert(length_v<typelist<int>> == 1);
+            operational_ = true;
+        }
 
-    // front_t
+        bool
+        operational() const noexcept
+        {
+            return operational_;
+        }
 
-    template <typename TL>
-    using front_t = detail::front_type<TL>::type;
+      private:
+        scheduler        &sched_;
+        std::atomic<bool> operational_ = true;
+    };
+} // namespace n709d
 
-    static_assert(std::is_same_v<front_t<typelist<>>, empty_type>);
-    static_assert(std::is_same_v<front_t<typelist<int>>, int>);
-    static_assert(std::is_same_v<front_t<typelist<int, double, char>>, int>);
+namespace n709e
+{
+    // Intrusive reference counting with CRTP (compare limited_instances in n704).
+    // The count lives inside the object: no separate control block, and an intrusive_ptr is a
+    // single pointer. The counting policy decides between atomic and plain (single-threaded) counts.
 
-    // back_t
+    struct atomic_count
+    {
+        using type = std::atomic<std::size_t>;
 
-    template <typename TL>
-    using back_t = detail::back_type<TL>::type;
+        static void
+        increment(type &c) noexcept
+        {
+            c.fetch_add(1, std::memory_order_relaxed);
+        }
 
-    static_assert(std::is_same_v<back_t<typelist<>>, empty_type>);
-    static_assert(std::is_same_v<back_t<typelist<int>>, int>);
-    static_assert(std::is_same_v<back_t<typelist<int, double, char>>, char>);
+        // returns true when the last reference is gone
+        static bool
+        decrement(type &c) noexcept
+        {
+            return c.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+    };
 
-    // push_back_t
+    // only for objects that are never shared between threads (e.g. a single-threaded scheduler)
+    struct non_atomic_count
+    {
+        using type = std::size_t;
 
-    template <typename TL, typename T>
-    using push_back_t = detail::push_back_type<TL, T>::type;
+        static void
+        increment(type &c) noexcept
+        {
+            ++c;
+        }
 
-    static_assert(std::is_same_v<push_back_t<typelist<>, int>, typelist<int>>);
-    static_assert(std::is_same_v<push_back_t<typelist<char>, int>, typelist<char, int>>);
-    static_assert(std::is_same_v<push_back_t<typelist<double, char>, int>, typelist<double, char, int>>);
+        static bool
+        decrement(type &c) noexcept
+        {
+            return --c == 0;
+        }
+    };
 
-    // push_front_t
+    template <typename T>
+    class intrusive_ptr;
 
-    template <typename TL, typename T>
-    using push_front_t = detail::push_front_type<TL, T>::type;
+    template <typename T, typename Count = atomic_count>
+    struct intrusive_ref_counted
+    {
+        intrusive_ref_counted() = default;
 
-    static_assert(std::is_same_v<push_front_t<typelist<>, int>, typelist<int>>);
-    static_assert(std::is_same_v<push_front_t<typelist<char>, int>, typelist<int, char>>);
-    static_assert(std::is_same_v<push_front_t<typelist<double, char>, int>, typelist<int, double, char>>);
+        // copies get their own count
+        intrusive_ref_counted(intrusive_ref_counted const &) noexcept
+        {
+        }
 
-    // pop_front_t
+        intrusive_ref_counted &
+        operator=(intrusive_ref_counted const &) noexcept
+        {
+            return *this;
+        }
 
-    template <typename TL>
-    using pop_front_t = detail::pop_front_type<TL>::type;
+        // counterpart of shared_from_this(); the object must already be owned by an intrusive_ptr
+        intrusive_ptr<T>
+        intrusive_from_this() noexcept
+        {
+            return intrusive_ptr<T>{static_cast<T *>(this)};
+        }
 
-    static_assert(std::is_same_v<pop_front_t<typelist<>>, typelist<>>);
-    static_assert(std::is_same_v<pop_front_t<typelist<char>>, typelist<>>);
-    static_assert(std::is_same_v<pop_front_t<typelist<double, char>>, typelist<char>>);
+        std::size_t
+        use_count() const noexcept
+        {
+            return count_;
+        }
 
-    // pop_back_t
+        friend void
+        intrusive_add_ref(intrusive_ref_counted const *p) noexcept
+        {
+            Count::increment(p->count_);
+        }
 
-    template <typename TL>
-    using pop_back_t = detail::pop_back_type<static_cast<std::ptrdiff_t>(length_v<TL>) - 1, typelist<>, TL>::type;
+        friend void
+        intrusive_release(intrusive_ref_counted const *p) noexcept
+        {
+            if (Count::decrement(p->count_))
+            {
+                delete static_cast<T const *>(p); // downcast to the derived class (CRTP)
+            }
+        }
 
-    static_assert(std::is_same_v<pop_back_t<typelist<>>, typelist<>>);
-    static_assert(std::is_same_v<pop_back_t<typelist<double>>, typelist<>>);
-    static_assert(std::is_same_v<pop_back_t<typelist<double, char>>, typelist<double>>);
-    static_assert(std::is_same_v<pop_back_t<typelist<double, char, int>>, typelist<double, char>>);
+      protected:
+        ~intrusive_ref_counted() = default;
 
-    // at_t
+      private:
+        mutable typename Count::type count_{0};
+    };
 
-    template <std::size_t I, typename TL>
-    using at_t = detail::at_type<I, 0, TL>::type;
+    template <typename T>
+    class intrusive_ptr
+    {
+      public:
+        intrusive_ptr() noexcept = default;
 
-    static_assert(std::is_same_v<at_t<0, typelist<>>, empty_type>);
-    static_assert(std::is_same_v<at_t<0, typelist<int>>, int>);
-    static_assert(std::is_same_v<at_t<0, typelist<int, char>>, int>);
+        explicit intrusive_ptr(T *p) noexcept : ptr_(p)
+        {
+            if (ptr_)
+            {
+                intrusive_add_ref(ptr_);
+            }
+        }
 
-    static_assert(std::is_same_v<at_t<1, typelist<>>, empty_type>);
-    static_assert(std::is_same_v<at_t<1, typelist<int>>, empty_type>);
-    static_assert(std::is_same_v<at_t<1, typelist<int, char>>, char>);
+        intrusive_ptr(intrusive_ptr const &other) noexcept : intrusive_ptr(other.ptr_)
+        {
+        }
 
-    static_assert(std::is_same_v<at_t<2, typelist<>>, empty_type>);
-    static_assert(std::is_same_v<at_t<2, typelist<int>>, empty_type>);
-    static_assert(std::is_same_v<at_t<2, typelist<int, char>>, empty_type>);
-} // namespace n714
+        intrusive_ptr(intrusive_ptr &&other) noexcept : ptr_(std::exchange(other.ptr_, nullptr))
+        {
+        }
 
-namespace n715
-{
-    struct game_unit
-    {
-        int attack;
-        int defense;
+        intrusive_ptr &
+        operator=(intrusive_ptr other) noexcept
+        {
+            std::swap(ptr_, other.ptr_);
+            return *this;
+        }
+
+        ~intrusive_ptr()
+        {
+            if (ptr_)
+            {
+                intrusive_release(ptr_);
+            }
+        }
+
+        T *
+        get() const noexcept
+        {
+            return ptr_;
+        }
+
+        T &
+        operator*() const noexcept
+        {
+            return *ptr_;
+        }
+
+        T *
+        operator->() const noexcept
+        {
+            return ptr_;
+        }
+
+        explicit
+        operator bool() const noexcept
+        {
+            return ptr_ != nullptr;
+        }
+
+      private:
+        T *ptr_ = nullptr;
     };
 
-    struct upgrade_defense
+    template <typename T, typename... Args>
+    intrusive_ptr<T>
+    make_intrusive(Args &&...args)
+    {
+        return intrusive_ptr<T>{new T(std::forward<Args>(args)...)};
+    }
+
+    static_assert(sizeof(intrusive_ptr<int>) == sizeof(int *));
+
+    // n709c::building with intrusive counting
+    template <typename Count>
+    struct basic_building : intrusive_ref_counted<basic_building<Count>, Count>
     {
+        template <typename Executor>
         void
-        operator()(game_unit &u)
+        upgrade(Executor &exec)
         {
-            u.defense = static_cast<int>(u.defense * 1.2);
+            // one pointer, one (maybe non-atomic) increment; moved into the task afterwards
+            exec.execute([self = this->intrusive_from_this()]() { self->do_upgrade(); });
+        }
+
+        std::size_t
+        upgrades() const noexcept
+        {
+            return upgrades_;
+        }
+
+      private:
+        void
+        do_upgrade()
+        {
+            upgrades_.fetch_add(1, std::memory_order_relaxed);
         }
+
+        std::atomic<std::size_t> upgrades_ = 0;
     };
 
-    struct upgrade_attack
+    using building       = basic_building<atomic_count>;
+    using local_building = basic_building<non_atomic_count>;
+
+    // the same with std::shared_ptr (for comparison)
+    struct shared_building : std::enable_shared_from_this<shared_building>
     {
+        template <typename Executor>
         void
-        operator()(game_unit &u)
+        upgrade(Executor &exec)
         {
-            u.attack += 2;
+            exec.execute([self = shared_from_this()]() { self->do_upgrade(); });
         }
-    };
 
-    using namespace n714;
+        std::size_t
+        upgrades() const noexcept
+        {
+            return upgrades_;
+        }
 
-    template <typename TL>
-    struct apply_functors
+      private:
+        void
+        do_upgrade()
+        {
+            upgrades_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::size_t> upgrades_ = 0;
+    };
+
+    // single-threaded run queue: tasks run on the thread that calls run()
+    struct inline_scheduler
     {
+        void
+        execute(n709c::executor::task_type task)
+        {
+            tasks_.push_back(std::move(task));
+        }
+
+        void
+        run()
+        {
+            for (auto &task : tasks_)
+            {
+                task();
+            }
+            tasks_.clear();
+        }
+
       private:
-        template <size_t I>
-        static void
-        apply(game_unit &unit)
+        std::vector<n709c::executor::task_type> tasks_;
+    };
+} // namespace n709e
+
+namespace n710b
+{
+    struct knight
+    {
+        void
+        step_forth()
         {
-            using F = at_t<I, TL>;
-            std::invoke(F{}, unit);
+            std::println("knight moves forward");
         }
 
-        template <size_t... I>
-        static void
-        apply_all(game_unit &unit, std::index_sequence<I...>)
+        void
+        step_back()
         {
-            (apply<I>(unit), ...);
+            std::println("knight moves back");
         }
+    };
 
-      public:
+    struct mage
+    {
         void
-        operator()(game_unit &unit) const
+        step_forth()
+        {
+            std::println("mage moves forward");
+        }
+
+        void
+        step_back()
+        {
+            std::println("mage moves back");
+        }
+    };
+
+    // inherits from knight or mage (just the opposite what CRTP does)
+    template <typename T>
+    struct movable_unit : T
+    {
+        void
+        advance(size_t steps)
+        {
+            while (steps--)
+            {
+                T::step_forth();
+            }
+        }
+
+        void
+        retreat(size_t steps)
+        {
+            while (steps--)
+            {
+                T::step_back();
+            }
+        }
+    };
+} // namespace n710b
+
+namespace n710a
+{
+    namespace
+    {
+        // Fighting strategies
+
+        struct hit_and_run
+        {
+            void
+            fight()
+            {
+                std::println("hit once hard then run");
+            }
+        };
+
+        struct last_man_standing
+        {
+            void
+            fight()
+            {
+                std::println("duel until one falls");
+            }
+        };
+    } // namespace
+
+    // mixin adds functionality to a class by inheritance (not CRTP)
+    // a knight can fight
+    template <typename Strategy>
+    struct knight : public Strategy
+    {
+        void
+        attack()
+        {
+            std::println("draw sword");
+            Strategy::fight();
+        }
+    };
+
+    // a mage can fight
+    template <typename Strategy>
+    struct mage : public Strategy
+    {
+        void
+        attack()
+        {
+            std::println("spell magic curse");
+            Strategy::fight();
+        }
+    };
+} // namespace n710a
+
+namespace n710c
+{
+    // fighting styles
+
+    struct aggressive_style
+    {
+        void
+        fight()
+        {
+            std::println("attack attack attack");
+        }
+    };
+
+    struct moderate_style
+    {
+        void
+        fight()
+        {
+            std::println("attack then defend");
+        }
+    };
+
+    // type of warrior
+
+    template <typename Fighting_Style>
+    struct lone_warrior : Fighting_Style
+    {
+        void
+        fight()
+        {
+            std::println("fighting alone");
+            Fighting_Style::fight();
+        }
+    };
+
+    template <typename T>
+    struct team_warrior : T
+    {
+        void
+        fight()
+        {
+            std::println("fighting with a team");
+            T::fight();
+        }
+    };
+
+    // virtual class
+
+    struct game_unit
+    {
+        virtual void attack() = 0;
+        virtual ~game_unit()  = default;
+    };
+
+    template <typename Type_Warrior_or_Fighting_Style>
+    struct knight : Type_Warrior_or_Fighting_Style, game_unit
+    {
+        void
+        attack()
+        {
+            std::println("draw sword");
+            Type_Warrior_or_Fighting_Style::fight();
+        }
+    };
+
+    template <typename T>
+    struct mage : T, game_unit
+    {
+        void
+        attack()
+        {
+            std::println("spell magic curse");
+            T::fight();
+        }
+    };
+} // namespace n710c
+
+namespace n711a
+{
+    namespace details
+    {
+        template <typename Iter, typename Distance>
+        void
+        advance(Iter &it, Distance n, std::random_access_iterator_tag)
+        {
+            it += n;
+        }
+
+        template <typename Iter, typename Distance>
+        void
+        advance(Iter &it, Distance n, std::bidirectional_iterator_tag)
+        {
+            if (n > 0)
+            {
+                while (n--)
+                {
+                    ++it;
+                }
+            }
+            else
+            {
+                while (n++)
+                {
+                    --it;
+                }
+            }
+        }
+
+        template <typename Iter, typename Distance>
+        void
+        advance(Iter &it, Distance n, std::input_iterator_tag)
+        {
+            while (n--)
+            {
+                ++it;
+            }
+        }
+    } // namespace details
+
+    template <typename Iter, typename Distance>
+    void
+    advance(Iter &it, Distance n)
+    {
+        details::advance(it, n, typename std::iterator_traits<Iter>::iterator_category{});
+    }
+} // namespace n711a
+
+namespace n711b
+{
+    template <std::random_access_iterator Iter, typename Distance>
+    void
+    advance(Iter &it, Distance n)
+    {
+        it += n;
+    }
+
+    template <std::bidirectional_iterator Iter, typename Distance>
+    void
+    advance(Iter &it, Distance n)
+    {
+        if (n > 0)
+        {
+            while (n--)
+            {
+                ++it;
+            }
+        }
+        else
+        {
+            while (n++)
+            {
+                --it;
+            }
+        }
+    }
+
+    template <std::input_iterator Iter, typename Distance>
+    void
+    advance(Iter &it, Distance n)
+    {
+        while (n--)
+        {
+            ++it;
+        }
+    }
+} // namespace n711b
+
+namespace n712e
+{
+    // Classical C-style type erasure:
+    // basically this means using a lot of void* and reinterpret_casts! ;-)
+
+    namespace
+    {
+
+        struct knight
+        {
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+        };
+
+        struct mage
+        {
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+        };
+    } // namespace
+
+    namespace
+    {
+        // all types erased; only void pointers
+
+        void
+        fight_knight(void *k)
+        {
+            reinterpret_cast<knight *>(k)->attack();
+        }
+
+        void
+        fight_mage(void *m)
+        {
+            reinterpret_cast<mage *>(m)->attack();
+        }
+
+        using fight_fn                  = void (*)(void *);
+        using mapping_void_ptr_fight_fn = std::pair<void *, fight_fn>;
+
+        void
+        fight(std::vector<mapping_void_ptr_fight_fn> const &units)
+        {
+            for (auto &unit : units)
+            {
+                unit.second(unit.first);
+            }
+        }
+    } // namespace
+} // namespace n712e
+
+namespace n712a
+{
+    // Type erasure using polymorphism and inheritance.
+
+    namespace
+    {
+        struct knight
+        {
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+        };
+
+        struct mage
+        {
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+        };
+    } // namespace
+
+    namespace
+    {
+        struct game_unit
+        {
+            virtual void attack() = 0;
+            virtual ~game_unit()  = default;
+        };
+
+        struct knight_unit : game_unit
+        {
+            knight_unit(knight &u) : k(u)
+            {
+            }
+
+            void
+            attack() override
+            {
+                k.attack();
+            }
+
+          private:
+            knight &k;
+        };
+
+        struct mage_unit : game_unit
+        {
+            mage_unit(mage &u) : m(u)
+            {
+            }
+
+            void
+            attack() override
+            {
+                m.attack();
+            }
+
+          private:
+            mage &m;
+        };
+    } // namespace
+
+    // It can be argued that types have not been completely erased.
+    // Both knight and mage are game_unit and the fight function handles
+    // anything that is a game_unit.
+    void
+    fight(std::vector<game_unit *> const &units) // knight and mage types erased
+    {
+        for (auto u : units)
+        {
+            u->attack();
+        }
+    }
+} // namespace n712a
+
+namespace n712b
+{
+    // removing code duplication using templates
+
+    namespace
+    {
+        struct knight
+        {
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+        };
+
+        struct mage
+        {
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+        };
+    } // namespace
+
+    struct game_unit
+    {
+        virtual void attack() = 0;
+        virtual ~game_unit()  = default;
+    };
+
+    // all types have been erased
+    template <typename T>
+    struct game_unit_wrapper : public game_unit
+    {
+        game_unit_wrapper(T &unit) : t(unit)
+        {
+        }
+
+        void
+        attack() override
+        {
+            t.attack();
+        }
+
+      private:
+        T &t;
+    };
+
+    void
+    fight(std::vector<game_unit *> const &units)
+    {
+        for (auto u : units)
+        {
+            u->attack();
+        }
+    }
+} // namespace n712b
+
+namespace n712c
+{
+    // Putting concept and model in a common class.
+    struct game
+    {
+        // In the type erasure pattern, the abstract base class is called
+        // a CONCEPT and the wrapper that inherits from it is called a MODEL.
+
+        // CONCEPT (the interface)
+        // everything is declared in terms of this concept (all types erased)
+        // duck typing: anything that can attack is a gameu_unit
+        // defines what a game_unit is (anything that can attack)
+        struct game_unit
+        {
+            virtual void attack() = 0;
+            virtual ~game_unit()  = default;
+        };
+
+        // MODEL (the implementation; inherits from concept)
+        template <typename T>
+        struct game_unit_wrapper : public game_unit
+        {
+            game_unit_wrapper(T &unit) : t(unit)
+            {
+            }
+
+            void
+            attack() override
+            {
+                t.attack(); // just forward attack()
+            }
+
+          private:
+            T &t;           // wrapper around this
+        };
+
+        // API
+
+        template <typename T>
+        void
+        addUnit(T &unit)
+        {
+            // using the copy constructor of game_unit_wrapper and unit
+            units.push_back(std::make_unique<game_unit_wrapper<T>>(unit));
+        }
+
+        void
+        fight()
+        {
+            for (auto &u : units)
+            {
+                u->attack();
+            }
+        }
+
+      private:
+        std::vector<std::unique_ptr<game_unit>> units;
+    };
+
+    namespace
+    {
+        // knight and mage are game_units because they can attack()
+
+        struct knight
+        {
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+        };
+
+        struct mage
+        {
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+        };
+    } // namespace
+
+} // namespace n712c
+
+namespace n712d
+{
+    // General pattern
+
+    struct unit
+    {
+        // API
+
+        // template constructor that enables us to create model objects from, e.g. knight and mage objects.
+        template <typename T>
+        unit(T &&obj) : unit_(std::make_shared<unit_model<T>>(std::forward<T>(obj)))
+        {
+        }
+
+        void
+        attack()
+        {
+            unit_->attack();
+        }
+
+        // concept
+        struct unit_concept
+        {
+            virtual void attack()   = 0;
+            virtual ~unit_concept() = default;
+        };
+
+        // model (inherits from concept)
+        template <typename T>
+        struct unit_model : public unit_concept
+        {
+            unit_model(T &unit) : t(unit)
+            {
+            }
+
+            void
+            attack() override
+            {
+                t.attack();                  // forward attack()
+            }
+
+          private:
+            T &t;                            // unit_model is just a wrapper around a T
+        };
+
+      private:
+        std::shared_ptr<unit_concept> unit_; // a unit is a wrapper around a concept
+    };
+
+    namespace
+    {
+        struct knight
+        {
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+        };
+
+        struct mage
+        {
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+        };
+    } // namespace
+
+    // defined in terms of units (type erased)
+    void
+    fight(std::vector<unit> &units)
+    {
+        for (auto &u : units)
+        {
+            u.attack();
+        }
+    }
+} // namespace n712d
+
+namespace n712f
+{
+    // Type erasure with small-buffer optimization: models up to Capacity bytes live inside the unit, bigger ones
+    // on the heap. Instead of a virtual base class every unit points to a static constexpr table of function
+    // pointers, one table per erased type (see sbo::storage). Units are values: copying a unit copies the
+    // erased object.
+
+    template <std::size_t Capacity>
+    class basic_unit
+    {
+      public:
+        template <typename T>
+            requires(!std::is_same_v<std::decay_t<T>, basic_unit>)
+        basic_unit(T &&obj)
+        {
+            using D = std::decay_t<T>;
+            storage_.template emplace<D>(operations_for<D, storage_type::template on_heap<D>>, std::forward<T>(obj));
+        }
+
+        void
+        attack()
+        {
+            storage_.table()->attack(storage_.data());
+        }
+
+        // true if a unit of type T is stored without heap allocation
+        template <typename T>
+        static constexpr bool
+        stores_inline()
+        {
+            return sbo::stores_inline<T, Capacity>;
+        }
+
+      private:
+        // the "vtable"
+        struct operations : sbo::copyable_lifetime
+        {
+            void (*attack)(void *);
+        };
+
+        template <typename T, bool Heap>
+        static constexpr operations operations_for{
+            sbo::copyable_lifetime_of<T, Heap>,
+            [](void *p) { sbo::object<T, Heap>(p).attack(); },
+        };
+
+        using storage_type = sbo::storage<Capacity, operations>;
+
+        // copying, moving and destroying is done by the storage; a moved-from unit is empty and may only be
+        // destroyed, assigned to or copied (the copy is empty as well)
+        storage_type storage_;
+    };
+
+    // knight and mage are empty, so 16 bytes of inline storage are plenty
+    using unit = basic_unit<16>;
+
+    static_assert(unit::stores_inline<n712d::knight>() && unit::stores_inline<n712d::mage>());
+
+    template <std::size_t Capacity>
+    void
+    fight(std::vector<basic_unit<Capacity>> &units)
+    {
+        for (auto &u : units)
+        {
+            u.attack();
+        }
+    }
+} // namespace n712f
+
+namespace n712g
+{
+    // Generating the concept/model boilerplate. An erased interface is described by a list of methods, each
+    // method by a signature and a (generic) lambda that calls the member on the concrete object:
+    //
+    //   struct attack  : method<void(), [](auto &self) { self.attack(); }> {};
+    //   struct defense : method<int() const noexcept, [](auto const &self) { return self.defense(); }> {};
+    //
+    //   using unit = poly<16, attack, defense>;
+    //   u.call<attack>();
+    //
+    // poly builds one static constexpr table per erased type that holds copy/move/destroy and one function
+    // pointer per method. Objects up to Capacity bytes are stored inline (see sbo::storage).
+
+    template <bool Const, bool Noexcept, typename R, typename... Args>
+    struct signature_info
+    {
+        static constexpr bool is_const    = Const;
+        static constexpr bool is_noexcept = Noexcept;
+
+        using self_pointer     = std::conditional_t<Const, void const *, void *>;
+        using function_pointer = R (*)(self_pointer, Args...) noexcept(Noexcept);
+
+        template <typename T>
+        using object_type = std::conditional_t<Const, T const, T>;
+
+        template <auto Call, typename T>
+        static constexpr bool invocable =
+            std::is_invocable_r_v<R, decltype(Call), object_type<T> &, Args...> &&
+            (!Noexcept || std::is_nothrow_invocable_v<decltype(Call), object_type<T> &, Args...>);
+
+        // the erased object is either in place or behind a pointer in the storage
+        template <auto Call, typename T, bool Heap>
+        static R
+        invoke(self_pointer p, Args... args) noexcept(Noexcept)
+        {
+            return std::invoke_r<R>(Call, sbo::object<object_type<T>, Heap>(p), std::forward<Args>(args)...);
+        }
+    };
+
+    template <typename Signature>
+    struct signature_traits;
+
+    template <typename R, typename... Args>
+    struct signature_traits<R(Args...)> : signature_info<false, false, R, Args...>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct signature_traits<R(Args...) const> : signature_info<true, false, R, Args...>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct signature_traits<R(Args...) noexcept> : signature_info<false, true, R, Args...>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct signature_traits<R(Args...) const noexcept> : signature_info<true, true, R, Args...>
+    {
+    };
+
+    template <typename Signature, auto Call>
+    struct method : signature_traits<Signature>
+    {
+        using traits = signature_traits<Signature>;
+
+        template <typename T>
+        static constexpr bool applicable = traits::template invocable<Call, T>;
+
+        template <typename T, bool Heap>
+        static constexpr typename traits::function_pointer thunk = &traits::template invoke<Call, T, Heap>;
+    };
+
+    template <std::size_t Capacity, typename... Methods>
+    class poly
+    {
+      public:
+        template <typename T>
+            requires(!std::is_same_v<std::decay_t<T>, poly> && std::copy_constructible<std::decay_t<T>> &&
+                     (Methods::template applicable<std::decay_t<T>> && ...))
+        poly(T &&obj)
+        {
+            using D = std::decay_t<T>;
+            storage_.template emplace<D>(operations_for<D, storage_type::template on_heap<D>>, std::forward<T>(obj));
+        }
+
+        template <typename Method, typename... Args>
+        decltype(auto)
+        call(Args &&...args) noexcept(Method::is_noexcept)
+        {
+            auto const method = std::get<index_of<Method>()>(storage_.table()->methods);
+            return method(storage_.data(), std::forward<Args>(args)...);
+        }
+
+        template <typename Method, typename... Args>
+            requires Method::is_const
+        decltype(auto)
+        call(Args &&...args) const noexcept(Method::is_noexcept)
+        {
+            auto const method = std::get<index_of<Method>()>(storage_.table()->methods);
+            return method(storage_.data(), std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        static constexpr bool
+        stores_inline()
+        {
+            return sbo::stores_inline<T, Capacity>;
+        }
+
+      private:
+        template <typename Method>
+        static constexpr std::size_t
+        index_of()
+        {
+            static_assert((std::is_same_v<Method, Methods> || ...), "method is not part of the interface");
+            constexpr bool matches[] = {std::is_same_v<Method, Methods>...};
+            return static_cast<std::size_t>(std::ranges::find(matches, true) - std::ranges::begin(matches));
+        }
+
+        struct operations : sbo::copyable_lifetime
+        {
+            std::tuple<typename Methods::function_pointer...> methods;
+        };
+
+        template <typename T, bool Heap>
+        static constexpr operations operations_for{
+            sbo::copyable_lifetime_of<T, Heap>,
+            {Methods::template thunk<T, Heap>...},
+        };
+
+        using storage_type = sbo::storage<Capacity, operations>;
+
+        storage_type storage_; // a moved-from poly is empty
+    };
+
+    // an interface with three methods
+
+    struct attack : method<void(), [](auto &self) { self.attack(); }>
+    {
+    };
+
+    struct defense : method<int() const noexcept, [](auto const &self) noexcept { return self.defense(); }>
+    {
+    };
+
+    struct upgrade : method<void(int), [](auto &self, int level) { self.upgrade(level); }>
+    {
+    };
+
+    using unit = poly<16, attack, defense, upgrade>;
+
+    namespace
+    {
+        struct knight
+        {
+            int armor = 10;
+
+            void
+            attack()
+            {
+                std::println("draw sword");
+            }
+
+            int
+            defense() const noexcept
+            {
+                return armor;
+            }
+
+            void
+            upgrade(int level)
+            {
+                armor += level;
+            }
+        };
+
+        struct mage
+        {
+            int shield = 5;
+
+            void
+            attack()
+            {
+                std::println("spell magic curse");
+            }
+
+            int
+            defense() const noexcept
+            {
+                return shield;
+            }
+
+            void
+            upgrade(int level)
+            {
+                shield += 2 * level;
+            }
+        };
+    } // namespace
+
+    void
+    fight(std::vector<unit> &units)
+    {
+        for (auto &u : units)
+        {
+            u.call<attack>();
+        }
+    }
+} // namespace n712g
+
+namespace n712h
+{
+    // Non-owning type erasure: a unit_ref is just the address of the object and the address of a function that
+    // knows its type. It is passed by value, never allocates and calling attack() is one indirect call.
+    // Like a reference (or std::string_view) it must not outlive the object.
+
+    class unit_ref
+    {
+      public:
+        template <typename T>
+            requires(!std::is_same_v<std::remove_const_t<T>, unit_ref>)
+        unit_ref(T &obj) noexcept
+            : object_(std::addressof(obj)), attack_([](void *p) { static_cast<T *>(p)->attack(); })
+        {
+        }
+
+        void
+        attack() const
+        {
+            attack_(object_);
+        }
+
+      private:
+        void *object_;
+        void (*attack_)(void *);
+    };
+
+    static_assert(sizeof(unit_ref) == 2 * sizeof(void *));
+
+    // the same for any callable
+
+    template <typename Signature>
+    class function_ref;
+
+    template <typename R, typename... Args>
+    class function_ref<R(Args...)>
+    {
+      public:
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref> && !std::is_pointer_v<std::decay_t<F>> &&
+                     std::is_invocable_r_v<R, F &, Args...>)
+        function_ref(F &&f) noexcept
+            : object_(const_cast<void *>(static_cast<void const *>(std::addressof(f)))),
+              invoke_([](void *p, Args... args) -> R {
+                  return std::invoke_r<R>(*static_cast<std::remove_reference_t<F> *>(p), std::forward<Args>(args)...);
+              })
+        {
+        }
+
+        // plain functions are stored by their address
+        function_ref(R (*f)(Args...)) noexcept
+            : object_(reinterpret_cast<void *>(f)), invoke_([](void *p, Args... args) -> R {
+                  return reinterpret_cast<R (*)(Args...)>(p)(std::forward<Args>(args)...);
+              })
+        {
+        }
+
+        R
+        operator()(Args... args) const
+        {
+            return invoke_(object_, std::forward<Args>(args)...);
+        }
+
+      private:
+        void *object_;
+        R (*invoke_)(void *, Args...);
+    };
+
+    // the callback is only borrowed for the duration of the call
+    void
+    fight(std::span<unit_ref const> units, function_ref<void(std::size_t)> on_attack)
+    {
+        for (std::size_t i = 0; i < units.size(); ++i)
+        {
+            units[i].attack();
+            on_attack(i);
+        }
+    }
+} // namespace n712h
+
+namespace n713
+{
+    class async_bool
+    {
+        std::function<bool()> check;
+
+      public:
+        async_bool() = delete;
+
+        async_bool(std::function<bool()> checkIt) : check(checkIt)
+        {
+        }
+
+        async_bool(bool val) : check([val] { return val; })
+        {
+        }
+
+        static async_bool
+        yes()
+        {
+            return async_bool{[] { return true; }()};
+        }
+
+        static async_bool
+        no()
+        {
+            return async_bool{[] { return false; }()};
+        }
+
+        bool
+        operator&&(bool fore) const
+        {
+            return fore && check();
+        }
+        bool
+        operator!() const
+        {
+            return !check();
+        }
+        operator bool() const
+        {
+            return check();
+        }
+    };
+} // namespace n713
+
+// Typelists
+//
+// Today, perhaps many of the problems for which typelists represented the solution
+// can be also solved using variadic templates.
+
+namespace n714
+{
+    template <typename... Ts>
+    struct typelist
+    {
+    };
+
+    struct empty_type
+    {
+    };
+
+    // typical namespace name for implementation details
+    namespace detail
+    {
+        // length
+
+        template <typename TL>
+        struct length;
+
+        template <template <typename...> typename TL, typename... Ts>
+        struct length<TL<Ts...>>
+        {
+            using type = std::integral_constant<std::size_t, sizeof...(Ts)>;
+        };
+
+        // front_type
+
+        template <typename TL>
+        struct front_type;
+
+        template <template <typename...> typename TL, typename T, typename... Ts>
+        struct front_type<TL<T, Ts...>>
+        {
+            using type = T;
+        };
+
+        template <template <typename...> typename TL>
+        struct front_type<TL<>>
+        {
+            using type = empty_type;
+        };
+
+        // at
+        //
+        // Recursing through the list costs one instantiation per element, and the instantiation depth limits the
+        // length of the list. Instead the list inherits from one indexed<I, T> per element; overload resolution
+        // against that base deduces the type at position I in a single step.
+
+        template <std::size_t I, typename T>
+        struct indexed
+        {
+            using type = T;
+        };
+
+        template <typename Is, typename... Ts>
+        struct indexer;
+
+        template <std::size_t... Is, typename... Ts>
+        struct indexer<std::index_sequence<Is...>, Ts...> : indexed<Is, Ts>...
+        {
+        };
+
+        template <std::size_t I, typename T>
+        indexed<I, T> select(indexed<I, T> const &); // only used in decltype
+
+        // wrong index
+        template <std::size_t I, typename TL>
+        struct at_type
+        {
+            using type = empty_type;
+        };
+
+        template <std::size_t I, template <typename...> typename TL, typename... Ts>
+            requires(I < sizeof...(Ts))
+        struct at_type<I, TL<Ts...>>
+        {
+            using type = decltype(select<I>(std::declval<indexer<std::index_sequence_for<Ts...>, Ts...>>()))::type;
+        };
+
+        // back_type
+
+        template <typename TL>
+        struct back_type;
+
+        template <template <typename...> typename TL, typename... Ts>
+        struct back_type<TL<Ts...>>
+        {
+            using type = at_type<sizeof...(Ts) - 1, TL<Ts...>>::type; // wraps around for TL<>: wrong index
+        };
+
+        // push_back
+
+        template <typename TL, typename T>
+        struct push_back_type;
+
+        template <template <typename...> typename TL, typename T, typename... Ts>
+        struct push_back_type<TL<Ts...>, T>
+        {
+            using type = TL<Ts..., T>;
+        };
+
+        // push_front
+
+        template <typename TL, typename T>
+        struct push_front_type;
+
+        template <template <typename...> typename TL, typename T, typename... Ts>
+        struct push_front_type<TL<Ts...>, T>
+        {
+            using type = TL<T, Ts...>;
+        };
+
+        // pop_front
+
+        template <typename TL>
+        struct pop_front_type;
+
+        template <template <typename...> typename TL, typename T, typename... Ts>
+        struct pop_front_type<TL<T, Ts...>>
+        {
+            using type = TL<Ts...>;
+        };
+
+        template <template <typename...> typename TL>
+        struct pop_front_type<TL<>>
+        {
+            using type = TL<>;
+        };
+
+        // select_type: the types at the positions Is
+
+        template <typename TL, typename Is>
+        struct select_type;
+
+        template <template <typename...> typename TL, typename... Ts, std::size_t... Is>
+        struct select_type<TL<Ts...>, std::index_sequence<Is...>>
+        {
+            using type = TL<typename at_type<Is, TL<Ts...>>::type...>;
+        };
+
+        // keep_type: the types where Keep (a std::array<bool, N>) is true
+
+        template <typename TL, auto Keep>
+        struct keep_type;
+
+        template <template <typename...> typename TL, typename... Ts, auto Keep>
+        struct keep_type<TL<Ts...>, Keep>
+        {
+            static constexpr auto positions = []() {
+                std::array<std::size_t, std::ranges::count(Keep, true)> result{};
+                std::size_t                                              j = 0;
+                for (std::size_t i = 0; i < Keep.size(); ++i)
+                {
+                    if (Keep[i])
+                    {
+                        result[j++] = i;
+                    }
+                }
+                return result;
+            }();
+
+            template <std::size_t... Is>
+            static auto select(std::index_sequence<Is...>)
+                -> select_type<TL<Ts...>, std::index_sequence<positions[Is]...>>::type;
+
+            using type = decltype(select(std::make_index_sequence<positions.size()>{}));
+        };
+
+        // pop_back
+
+        template <typename TL>
+        struct pop_back_type;
+
+        template <template <typename...> typename TL, typename... Ts>
+        struct pop_back_type<TL<Ts...>>
+        {
+            using type = select_type<TL<Ts...>, std::make_index_sequence<sizeof...(Ts) - 1>>::type;
+        };
+
+        template <template <typename...> typename TL>
+        struct pop_back_type<TL<>>
+        {
+            using type = TL<>;
+        };
+
+        // find: position of the first T, the length of the list if there is none
+
+        template <typename T, typename TL>
+        struct find_type;
+
+        template <typename T, template <typename...> typename TL, typename... Ts>
+        struct find_type<T, TL<Ts...>>
+        {
+            static constexpr std::size_t value = []() {
+                constexpr bool matches[] = {std::is_same_v<T, Ts>..., true};
+                std::size_t    i         = 0;
+                while (!matches[i])
+                {
+                    ++i;
+                }
+                return i;
+            }();
+        };
+
+        // transform
+
+        template <typename TL, template <typename> typename F>
+        struct transform_type;
+
+        template <template <typename...> typename TL, typename... Ts, template <typename> typename F>
+        struct transform_type<TL<Ts...>, F>
+        {
+            using type = TL<F<Ts>...>;
+        };
+
+        // filter
+
+        template <typename TL, template <typename> typename Pred>
+        struct filter_type;
+
+        template <template <typename...> typename TL, typename... Ts, template <typename> typename Pred>
+        struct filter_type<TL<Ts...>, Pred>
+        {
+            using type = keep_type<TL<Ts...>, std::array<bool, sizeof...(Ts)>{Pred<Ts>::value...}>::type;
+        };
+
+        // unique: keeps the first occurrence of each type
+
+        template <typename TL, typename Is>
+        struct unique_type;
+
+        template <template <typename...> typename TL, typename... Ts, std::size_t... Is>
+        struct unique_type<TL<Ts...>, std::index_sequence<Is...>>
+        {
+            using type =
+                keep_type<TL<Ts...>, std::array<bool, sizeof...(Ts)>{(find_type<Ts, TL<Ts...>>::value == Is)...}>::type;
+        };
+    } // namespace detail
+
+    // length_t
+
+    template <typename TL>
+    using length_t = detail::length<TL>::type; // is an integral_constant
+
+    static_assert(length_t<typelist<int, double, char>>::value == 3);
+
+    // length_v
+
+    template <typename TL>
+    inline constexpr std::size_t length_v = length_t<TL>::value;
+
+    static_assert(length_v<typelist<int, double, char>> == 3);
+    static_assert(length_v<typelist<int, double>> == 2);
+    static_assert(length_v<typelist<int>> == 1);
+
+    // front_t
+
+    template <typename TL>
+    using front_t = detail::front_type<TL>::type;
+
+    static_assert(std::is_same_v<front_t<typelist<>>, empty_type>);
+    static_assert(std::is_same_v<front_t<typelist<int>>, int>);
+    static_assert(std::is_same_v<front_t<typelist<int, double, char>>, int>);
+
+    // back_t
+
+    template <typename TL>
+    using back_t = detail::back_type<TL>::type;
+
+    static_assert(std::is_same_v<back_t<typelist<>>, empty_type>);
+    static_assert(std::is_same_v<back_t<typelist<int>>, int>);
+    static_assert(std::is_same_v<back_t<typelist<int, double, char>>, char>);
+
+    // push_back_t
+
+    template <typename TL, typename T>
+    using push_back_t = detail::push_back_type<TL, T>::type;
+
+    static_assert(std::is_same_v<push_back_t<typelist<>, int>, typelist<int>>);
+    static_assert(std::is_same_v<push_back_t<typelist<char>, int>, typelist<char, int>>);
+    static_assert(std::is_same_v<push_back_t<typelist<double, char>, int>, typelist<double, char, int>>);
+
+    // push_front_t
+
+    template <typename TL, typename T>
+    using push_front_t = detail::push_front_type<TL, T>::type;
+
+    static_assert(std::is_same_v<push_front_t<typelist<>, int>, typelist<int>>);
+    static_assert(std::is_same_v<push_front_t<typelist<char>, int>, typelist<int, char>>);
+    static_assert(std::is_same_v<push_front_t<typelist<double, char>, int>, typelist<int, double, char>>);
+
+    // pop_front_t
+
+    template <typename TL>
+    using pop_front_t = detail::pop_front_type<TL>::type;
+
+    static_assert(std::is_same_v<pop_front_t<typelist<>>, typelist<>>);
+    static_assert(std::is_same_v<pop_front_t<typelist<char>>, typelist<>>);
+    static_assert(std::is_same_v<pop_front_t<typelist<double, char>>, typelist<char>>);
+
+    // pop_back_t
+
+    template <typename TL>
+    using pop_back_t = detail::pop_back_type<TL>::type;
+
+    static_assert(std::is_same_v<pop_back_t<typelist<>>, typelist<>>);
+    static_assert(std::is_same_v<pop_back_t<typelist<double>>, typelist<>>);
+    static_assert(std::is_same_v<pop_back_t<typelist<double, char>>, typelist<double>>);
+    static_assert(std::is_same_v<pop_back_t<typelist<double, char, int>>, typelist<double, char>>);
+
+    // at_t
+
+    template <std::size_t I, typename TL>
+    using at_t = detail::at_type<I, TL>::type;
+
+    static_assert(std::is_same_v<at_t<0, typelist<>>, empty_type>);
+    static_assert(std::is_same_v<at_t<0, typelist<int>>, int>);
+    static_assert(std::is_same_v<at_t<0, typelist<int, char>>, int>);
+
+    static_assert(std::is_same_v<at_t<1, typelist<>>, empty_type>);
+    static_assert(std::is_same_v<at_t<1, typelist<int>>, empty_type>);
+    static_assert(std::is_same_v<at_t<1, typelist<int, char>>, char>);
+
+    static_assert(std::is_same_v<at_t<2, typelist<>>, empty_type>);
+    static_assert(std::is_same_v<at_t<2, typelist<int>>, empty_type>);
+    static_assert(std::is_same_v<at_t<2, typelist<int, char>>, empty_type>);
+
+    static_assert(std::is_same_v<at_t<1, typelist<int, int, char>>, int>); // duplicates are distinct bases
+
+    // find_v
+
+    template <typename T, typename TL>
+    inline constexpr std::size_t find_v = detail::find_type<T, TL>::value;
+
+    static_assert(find_v<int, typelist<>> == 0);
+    static_assert(find_v<int, typelist<int, char, int>> == 0);
+    static_assert(find_v<char, typelist<int, char, int>> == 1);
+    static_assert(find_v<long, typelist<int, char, int>> == 3);
+
+    // transform_t
+    //
+    // F is applied as is, so pass an alias template like std::add_const_t rather than the trait std::add_const.
+
+    template <typename TL, template <typename> typename F>
+    using transform_t = detail::transform_type<TL, F>::type;
+
+    static_assert(std::is_same_v<transform_t<typelist<>, std::add_const_t>, typelist<>>);
+    static_assert(std::is_same_v<transform_t<typelist<int, char>, std::add_const_t>, typelist<int const, char const>>);
+
+    // filter_t
+    //
+    // Pred is a trait with a boolean value, e.g. std::is_integral.
+
+    template <typename TL, template <typename> typename Pred>
+    using filter_t = detail::filter_type<TL, Pred>::type;
+
+    static_assert(std::is_same_v<filter_t<typelist<>, std::is_integral>, typelist<>>);
+    static_assert(std::is_same_v<filter_t<typelist<int, double, char>, std::is_integral>, typelist<int, char>>);
+    static_assert(std::is_same_v<filter_t<typelist<double, float>, std::is_integral>, typelist<>>);
+
+    // unique_t
+
+    template <typename TL>
+    using unique_t = detail::unique_type<TL, std::make_index_sequence<length_v<TL>>>::type;
+
+    static_assert(std::is_same_v<unique_t<typelist<>>, typelist<>>);
+    static_assert(std::is_same_v<unique_t<typelist<int, char>>, typelist<int, char>>);
+    static_assert(std::is_same_v<unique_t<typelist<int, char, int, double, char>>, typelist<int, char, double>>);
+
+    // The algorithms above need no recursion, so the instantiation depth doesn't grow with the length of a list.
+    // To see how the build time grows instead, compile with a list length, e.g.
+    //
+    //   for n in 100 200 400 800 1600; do echo $n; time g++ -std=c++23 -fsyntax-only -DN714_LENGTH=$n main.cpp; done
+
+#ifdef N714_LENGTH
+    namespace benchmark
+    {
+        template <std::size_t I>
+        using element = std::integral_constant<std::size_t, I % (N714_LENGTH / 2)>; // every type occurs twice
+
+        template <typename Is>
+        struct make_list;
+
+        template <std::size_t... Is>
+        struct make_list<std::index_sequence<Is...>>
+        {
+            using type = typelist<element<Is>...>;
+        };
+
+        using list = make_list<std::make_index_sequence<N714_LENGTH>>::type;
+
+        template <typename T>
+        using is_even = std::bool_constant<T::value % 2 == 0>;
+
+        template <typename T>
+        using next = element<T::value + 1>;
+
+        static_assert(std::is_same_v<at_t<N714_LENGTH - 1, list>, element<N714_LENGTH - 1>>);
+        static_assert(length_v<pop_back_t<list>> == N714_LENGTH - 1);
+        static_assert(find_v<element<N714_LENGTH / 2 - 1>, list> == N714_LENGTH / 2 - 1);
+        static_assert(length_v<transform_t<list, next>> == N714_LENGTH);
+        static_assert(length_v<filter_t<list, is_even>> == (N714_LENGTH / 2 + 1) / 2 * 2);
+        static_assert(length_v<unique_t<list>> == N714_LENGTH / 2);
+    } // namespace benchmark
+#endif
+} // namespace n714
+
+namespace n715
+{
+    struct game_unit
+    {
+        int attack;
+        int defense;
+    };
+
+    struct upgrade_defense
+    {
+        void
+        operator()(game_unit &u)
+        {
+            u.defense = static_cast<int>(u.defense * 1.2);
+        }
+    };
+
+    struct upgrade_attack
+    {
+        void
+        operator()(game_unit &u)
+        {
+            u.attack += 2;
+        }
+    };
+
+    using namespace n714;
+
+    template <typename TL>
+    struct apply_functors
+    {
+      private:
+        template <size_t I>
+        static void
+        apply(game_unit &unit)
+        {
+            using F = at_t<I, TL>;
+            std::invoke(F{}, unit);
+        }
+
+        template <size_t... I>
+        static void
+        apply_all(game_unit &unit, std::index_sequence<I...>)
+        {
+            (apply<I>(unit), ...);
+        }
+
+      public:
+        void
+        operator()(game_unit &unit) const
+        {
+            apply_all(unit, std::make_index_sequence<length_v<TL>>{});
+        }
+    };
+
+    void
+    upgrade_unit(game_unit &unit)
+    {
+        using upgrade_types = typelist<upgrade_defense, upgrade_attack>;
+        apply_functors<upgrade_types>{}(unit);
+    }
+
+    // this doesn't work
+    // template <typename... Ts>
+    // struct transformer
+    // {
+    //     using input_types  = Ts...;
+    //     using output_types = std::add_const_t<Ts>...;
+    // };
+
+    template <typename... Ts>
+    struct transformer
+    {
+        using input_types  = typelist<Ts...>;
+        using output_types = typelist<std::add_const_t<Ts>...>;
+    };
+
+    static_assert(std::is_same_v<transformer<int, double>::output_types, typelist<int const, double const>>);
+} // namespace n715
+
+namespace n715b
+{
+    // When all unit types are known at compile time we don't need type erasure. A std::variant holds any of them
+    // inline, so a vector of variants keeps all units contiguous without one heap allocation per unit. std::visit
+    // dispatches through a jump table instead of a vtable.
+
+    using namespace n714;
+
+    // rebind_t: the types of a typelist as arguments of another template, e.g. std::variant
+
+    template <template <typename...> typename To, typename TL>
+    struct rebind;
+
+    template <template <typename...> typename To, template <typename...> typename TL, typename... Ts>
+    struct rebind<To, TL<Ts...>>
+    {
+        using type = To<Ts...>;
+    };
+
+    template <template <typename...> typename To, typename TL>
+    using rebind_t = rebind<To, TL>::type;
+
+    static_assert(std::is_same_v<rebind_t<std::variant, typelist<int, char>>, std::variant<int, char>>);
+
+    // index_of_v: position of T in a typelist, length_v<TL> if T is not in it
+
+    template <typename T, typename TL>
+    inline constexpr std::size_t index_of_v = find_v<T, TL>;
+
+    template <typename T, typename TL>
+    concept member_of = index_of_v<T, TL> < length_v<TL>;
+
+    // count_of_v: how often T occurs in a typelist
+
+    template <typename T, typename TL>
+    struct count_of;
+
+    template <typename T, typename... Ts>
+    struct count_of<T, typelist<Ts...>>
+    {
+        static constexpr std::size_t value = (std::size_t{std::is_same_v<T, Ts>} + ... + 0);
+    };
+
+    template <typename T, typename TL>
+    inline constexpr std::size_t count_of_v = count_of<T, TL>::value;
+
+    static_assert(index_of_v<char, typelist<int, char>> == 1);
+    static_assert(index_of_v<long, typelist<int, char>> == 2);
+    static_assert(count_of_v<int, typelist<int, char, int>> == 2);
+
+    template <typename... Ts>
+    class unit_set
+    {
+      public:
+        using types      = typelist<Ts...>;
+        using value_type = rebind_t<std::variant, types>;
+
+        static_assert(((count_of_v<Ts, types> == 1) && ...), "unit types must be unique");
+
+        template <member_of<types> T, typename... Args>
+        T &
+        emplace(Args &&...args)
+        {
+            return std::get<T>(units_.emplace_back(std::in_place_type<T>, std::forward<Args>(args)...));
+        }
+
+        template <member_of<types> T>
+        void
+        push_back(T unit)
+        {
+            units_.emplace_back(std::move(unit));
+        }
+
+        void
+        reserve(size_t const n)
+        {
+            units_.reserve(n);
+        }
+
+        size_t
+        size() const
+        {
+            return units_.size();
+        }
+
+        auto
+        begin()
+        {
+            return units_.begin();
+        }
+
+        auto
+        end()
+        {
+            return units_.end();
+        }
+
+      private:
+        std::vector<value_type> units_;
+    };
+
+    // unit_set_t<typelist<knight, mage>> is unit_set<knight, mage>
+
+    template <typename TL>
+    using unit_set_t = rebind_t<unit_set, TL>;
+
+    template <typename... Ts>
+    void
+    fight(unit_set<Ts...> &units)
+    {
+        for (auto &u : units)
+        {
+            std::visit([](auto &unit) { unit.attack(); }, u);
+        }
+    }
+} // namespace n715b
+
+// Expression templates
+
+namespace n716
+{
+    // Allocates storage aligned to Alignment bytes (a cache line by default), so that SIMD code can use aligned
+    // loads and stores without peeling off the first elements.
+    template <typename T, std::size_t Alignment = 64>
+    struct aligned_allocator
+    {
+        static_assert(std::has_single_bit(Alignment) && Alignment >= alignof(T));
+
+        using value_type = T;
+
+        // needed because of the non-type template parameter
+        template <typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() = default;
+
+        template <typename U>
+        aligned_allocator(aligned_allocator<U, Alignment> const &) noexcept
+        {
+        }
+
+        T *
+        allocate(std::size_t const n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length{};
+            }
+            return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void
+        deallocate(T *const p, std::size_t const n) noexcept
+        {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{Alignment});
+        }
+
+        friend bool
+        operator==(aligned_allocator const &, aligned_allocator const &) noexcept
+        {
+            return true;
+        }
+    };
+
+    template <typename T, typename A = std::allocator<T>>
+    struct vector
+    {
+        vector(std::size_t const n) : data_(n)
+        {
+        }
+
+        vector(std::initializer_list<T> &&l) : data_(l)
+        {
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return data_.size();
+        }
+
+        T const &
+        operator[](const std::size_t i) const
+        {
+            return data_[i];
+        }
+
+        T &
+        operator[](const std::size_t i)
+        {
+            return data_[i];
+        }
+
+        T const *
+        data() const noexcept
+        {
+            return data_.data();
+        }
+
+      private:
+        std::vector<T, A> data_;
+    };
+
+    // results use the allocator of the left operand
+    template <typename A, typename T>
+    using rebind_t = std::allocator_traits<A>::template rebind_alloc<T>;
+
+    template <typename T, typename A, typename U, typename B>
+    auto
+    operator+(vector<T, A> const &a, vector<U, B> const &b)
+    {
+        using result_type = decltype(std::declval<T>() + std::declval<U>());
+
+        vector<result_type, rebind_t<A, result_type>> result(a.size());
+
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            result[i] = a[i] + b[i];
+        }
+        return result;
+    }
+
+    // dot product
+    template <typename T, typename A, typename U, typename B>
+    auto
+    operator*(vector<T, A> const &a, vector<U, B> const &b)
+    {
+        using result_type = decltype(std::declval<T>() * std::declval<U>());
+
+        vector<result_type, rebind_t<A, result_type>> result(a.size());
+
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            result[i] = a[i] * b[i];
+        }
+        return result;
+    }
+
+    // scalar product
+    template <typename T, typename A, typename S>
+    auto
+    operator*(S const &s, vector<T, A> const &v)
+    {
+        using result_type = decltype(std::declval<S>() + std::declval<T>());
+
+        vector<result_type, rebind_t<A, result_type>> result(v.size());
+
+        for (std::size_t i = 0; i < v.size(); ++i)
+        {
+            result[i] = s * v[i];
+        }
+
+        return result;
+    }
+} // namespace n716
+
+namespace n717
+{
+    using n716::aligned_allocator;
+
+    // Storage for a fixed number of elements (3D/4D math). The size is part of the type, so evaluation can be
+    // unrolled at compile time, and the elements are aligned so that a whole block can be loaded at once.
+    template <typename T, std::size_t N>
+    struct alignas(std::min<std::size_t>(std::bit_ceil(N * sizeof(T)), 64)) fixed_storage
+    {
+        static_assert(N > 0);
+
+        using value_type = T;
+
+        static constexpr std::size_t extent = N;
+
+        fixed_storage() = default;
+
+        fixed_storage(std::size_t const n)
+        {
+            if (n != N)
+            {
+                throw std::length_error{"size doesn't match the fixed extent"};
+            }
+        }
+
+        fixed_storage(std::initializer_list<T> l) : fixed_storage(l.size())
+        {
+            std::ranges::copy(l, elements);
+        }
+
+        static constexpr std::size_t
+        size() noexcept
+        {
+            return N;
+        }
+
+        T *
+        data() noexcept
+        {
+            return elements;
+        }
+
+        T const *
+        data() const noexcept
+        {
+            return elements;
+        }
+
+        T *
+        begin() noexcept
+        {
+            return elements;
+        }
+
+        T const *
+        begin() const noexcept
+        {
+            return elements;
+        }
+
+        T *
+        end() noexcept
+        {
+            return elements + N;
+        }
+
+        T const *
+        end() const noexcept
+        {
+            return elements + N;
+        }
+
+        T &
+        operator[](std::size_t const i) noexcept
+        {
+            return elements[i];
+        }
+
+        T const &
+        operator[](std::size_t const i) const noexcept
+        {
+            return elements[i];
+        }
+
+        T elements[N]{};
+    };
+
+    template <typename C>
+    inline constexpr bool is_fixed_storage_v = false;
+
+    template <typename T, std::size_t N>
+    inline constexpr bool is_fixed_storage_v<fixed_storage<T, N>> = true;
+
+    // SIMD evaluation
+    //
+    // Instead of calling operator[] once per element, the evaluator asks the expression tree for blocks (packs)
+    // of N elements. Packs are GCC/Clang vector extensions which the compiler maps onto the widest registers of
+    // the target: AVX-512 or AVX2 when compiling with e.g. -march=native, SSE2/NEON otherwise. The elements
+    // that don't fill a whole block are evaluated one by one. Whether an expression can be evaluated in packs
+    // is decided at compile time from its node and element types; if not, we fall back to operator[].
+    namespace simd
+    {
+#if defined(__AVX512F__)
+        inline constexpr std::size_t register_bytes = 64;
+#elif defined(__AVX__)
+        inline constexpr std::size_t register_bytes = 32;
+#else
+        inline constexpr std::size_t register_bytes = 16;
+#endif
+
+        template <typename T>
+        concept element = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+        template <element T, std::size_t N>
+        struct pack_type
+        {
+            typedef T type __attribute__((vector_size(N * sizeof(T))));
+        };
+
+        template <element T, std::size_t N>
+        using pack = pack_type<T, N>::type;
+
+        // leaves are contiguous containers, nodes tell whether all their operands can be evaluated in packs
+        template <typename E>
+        concept leaf = std::ranges::contiguous_range<E const> && element<std::ranges::range_value_t<E>>;
+
+        template <typename E>
+        concept evaluable = leaf<E> || requires { requires E::vectorizable; };
+
+        // alignment of the storage of a container in bytes, as far as it is known at compile time
+        template <typename C>
+        inline constexpr std::size_t alignment_v = alignof(std::ranges::range_value_t<C>);
+
+        template <typename T, std::size_t A>
+        inline constexpr std::size_t alignment_v<std::vector<T, aligned_allocator<T, A>>> = A;
+
+        template <typename T, std::size_t N>
+        inline constexpr std::size_t alignment_v<fixed_storage<T, N>> = alignof(fixed_storage<T, N>);
+
+        // Blocks start at multiples of N (see evaluate), so a block of aligned storage is aligned to the size of
+        // the block or the alignment of the storage, whichever is smaller.
+        template <std::size_t Alignment, typename P, typename T>
+        T *
+        block_address(T *const p)
+        {
+            return std::assume_aligned<std::min(sizeof(P), Alignment)>(p);
+        }
+
+        template <std::size_t N, typename E>
+        auto
+        load(E const &e, std::size_t const i)
+        {
+            if constexpr (leaf<E>)
+            {
+                using P = pack<std::ranges::range_value_t<E>, N>;
+
+                P p;
+                std::memcpy(&p, block_address<alignment_v<E>, P>(std::ranges::data(e) + i), sizeof(p));
+                return p;
+            }
+            else
+            {
+                return e.template load<N>(i);
+            }
+        }
+
+        template <element T, std::size_t N, typename P>
+        pack<T, N>
+        convert(P const &p)
+        {
+            return __builtin_convertvector(p, pack<T, N>);
+        }
+
+        template <element T, std::size_t N>
+        pack<T, N>
+        broadcast(T const value)
+        {
+            return pack<T, N>{} + value;
+        }
+
+        // Operations without an overload for packs (e.g. std::sqrt) are applied lane by lane; the compiler can
+        // still vectorize that loop when the target has a matching instruction.
+        template <element T, std::size_t N, typename Op, typename... Ps>
+        pack<T, N>
+        apply(Op const &op, Ps const &...ps)
+        {
+            if constexpr (std::is_invocable_v<Op const &, Ps const &...>)
+            {
+                return op(ps...);
+            }
+            else
+            {
+                pack<T, N> result;
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    result[k] = op(ps[k]...);
+                }
+                return result;
+            }
+        }
+
+        template <typename T>
+        inline constexpr std::size_t lanes = std::max<std::size_t>(register_bytes / sizeof(T), 1);
+
+        template <std::size_t OutAlignment, typename T, typename P>
+        void
+        store(T *const out, P const &p)
+        {
+            std::memcpy(block_address<OutAlignment, P>(out), &p, sizeof(p));
+        }
+
+        // Evaluates the elements [first, last) of e into out[first, last); out is aligned to OutAlignment bytes.
+        // Elements before the first multiple of N are evaluated one by one, so that all blocks of aligned
+        // storage are aligned, too.
+        template <std::size_t OutAlignment, typename T, typename E>
+        void
+        evaluate(T *const out, E const &e, std::size_t const first, std::size_t const last)
+        {
+            std::size_t i = first;
+            if constexpr (element<T> && evaluable<E>)
+            {
+                constexpr std::size_t N = lanes<T>;
+
+                for (; i < last && i % N != 0; ++i)
+                {
+                    out[i] = static_cast<T>(e[i]);
+                }
+                for (; i + N <= last; i += N)
+                {
+                    store<OutAlignment>(out + i, convert<T, N>(load<N>(e, i)));
+                }
+            }
+            for (; i < last; ++i)
+            {
+                out[i] = static_cast<T>(e[i]);
+            }
+        }
+
+        // the same for a size known at compile time: no loops at all
+        template <std::size_t Size, std::size_t OutAlignment, typename T, typename E>
+        void
+        evaluate_fixed(T *const out, E const &e)
+        {
+            constexpr std::size_t N      = lanes<T>;
+            constexpr std::size_t blocks = element<T> && evaluable<E> ? Size / N : 0;
+
+            [&]<std::size_t... B>(std::index_sequence<B...>) {
+                (store<OutAlignment>(out + B * N, convert<T, N>(load<N>(e, B * N))), ...);
+            }(std::make_index_sequence<blocks>{});
+
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((out[blocks * N + I] = static_cast<T>(e[blocks * N + I])), ...);
+            }(std::make_index_sequence<Size - blocks * N>{});
+        }
+
+        // sum of the first n elements of e in one pass, N partial sums at a time
+        template <typename T, typename E>
+        T
+        sum(E const &e, std::size_t const n)
+        {
+            T           total{};
+            std::size_t i = 0;
+            if constexpr (element<T> && evaluable<E>)
+            {
+                constexpr std::size_t N = lanes<T>;
+
+                pack<T, N> partial{};
+                for (; i + N <= n; i += N)
+                {
+                    partial += convert<T, N>(load<N>(e, i));
+                }
+                for (std::size_t k = 0; k < N; ++k)
+                {
+                    total += partial[k];
+                }
+            }
+            for (; i < n; ++i)
+            {
+                total += static_cast<T>(e[i]);
+            }
+            return total;
+        }
+    } // namespace simd
+
+    // Evaluating big expressions on several threads. The index range is split into one contiguous chunk per
+    // worker and every chunk is evaluated in packs straight into the destination, so we still make a single pass
+    // without temporaries.
+    namespace parallel
+    {
+        // below this number of elements handing the work to other threads costs more than it saves
+        inline constexpr std::size_t threshold = std::size_t{1} << 18;
+
+        inline n709c::executor &
+        default_pool()
+        {
+            static n709c::executor pool;
+            return pool;
+        }
+
+        template <std::size_t OutAlignment = 1, typename T, typename E>
+        void
+        evaluate(T *const out, E const &e, std::size_t const n, n709c::executor &pool)
+        {
+            struct chunk_task
+            {
+                T          *out;
+                E const    *e;
+                std::size_t first;
+                std::size_t last;
+
+                void
+                operator()() const
+                {
+                    simd::evaluate<OutAlignment>(out, *e, first, last);
+                }
+            };
+
+            // chunks are a multiple of 64 elements, so only the last one has a scalar tail
+            std::size_t const chunk = std::max<std::size_t>((n / pool.size() + 63) / 64 * 64, 64);
+
+            std::vector<chunk_task> tasks;
+            for (std::size_t first = 0; first < n; first += chunk)
+            {
+                tasks.push_back({out, &e, first, std::min(first + chunk, n)});
+            }
+
+            n709c::task_group group{pool};
+            group.run_bulk(tasks);
+            group.wait();
+        }
+    } // namespace parallel
+
+    namespace detail
+    {
+        // how the memory an expression reads relates to the memory [first, last) we are about to write
+        enum class overlap
+        {
+            none,
+            same,    // element i is only read where element i is written
+            partial, // elements are read that are written at another index
+        };
+
+        template <typename E>
+        overlap
+        aliasing(E const &e, void const *const first, void const *const last)
+        {
+            if constexpr (std::ranges::contiguous_range<E const>)
+            {
+                void const *const begin = std::ranges::data(e);
+                void const *const end   = std::ranges::data(e) + std::ranges::size(e);
+
+                std::less<> const less;
+                if (begin == end || !less(begin, last) || !less(first, end))
+                {
+                    return overlap::none;
+                }
+                return begin == first ? overlap::same : overlap::partial;
+            }
+            else if constexpr (requires { e.aliasing(first, last); })
+            {
+                return e.aliasing(first, last);
+            }
+            else
+            {
+                return overlap::partial; // unknown storage, assume the worst
+            }
+        }
+    } // namespace detail
+
+    // T is the result type
+    template <typename T, typename C = std::vector<T>>
+    struct vector
+    {
+        vector() = default;
+
+        vector(std::size_t const n) : data_(n)
+        {
+        }
+
+        vector(std::initializer_list<T> &&l) : data_(l)
+        {
+        }
+
+        vector(C const &other) : data_(other)
+        {
+        }
+
+        template <typename U, typename X>
+        vector(vector<U, X> const &other) : data_(other.size())
+        {
+            assign(other);
+        }
+
+        // The expression may read our own storage (a = a + b). All nodes are element-wise, so that is fine as
+        // long as element i is read only at index i and the storage stays where it is. Otherwise (or if we can't
+        // tell) the expression is evaluated into a temporary first.
+        template <typename U, typename X>
+        vector &
+        operator=(vector<U, X> const &other)
+        {
+            if constexpr (std::ranges::contiguous_range<C>)
+            {
+                auto const first   = std::ranges::data(data_);
+                auto const overlap = detail::aliasing(other.data(), first, first + size());
+
+                if (overlap == detail::overlap::none)
+                {
+                    resize(other.size());
+                    assign(other);
+                    return *this;
+                }
+                if (overlap == detail::overlap::same && other.size() == size())
+                {
+                    assign(other);
+                    return *this;
+                }
+            }
+
+            vector<T> result(other);
+            if constexpr (std::is_same_v<C, std::vector<T>>)
+            {
+                data_.swap(result.data());
+            }
+            else
+            {
+                resize(result.size());
+                std::ranges::copy(result.data(), std::ranges::begin(data_));
+            }
+
+            return *this;
+        }
+
+        // compound assignments evaluate straight into the existing storage (a single pass, no resize)
+
+        template <typename X>
+        vector &
+        operator+=(X const &other)
+        {
+            return *this = *this + other;
+        }
+
+        template <typename X>
+        vector &
+        operator-=(X const &other)
+        {
+            return *this = *this - other;
+        }
+
+        template <typename X>
+        vector &
+        operator*=(X const &other)
+        {
+            return *this = *this * other;
+        }
+
+        template <typename X>
+        vector &
+        operator/=(X const &other)
+        {
+            return *this = *this / other;
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return data_.size();
+        }
+
+        T
+        operator[](const std::size_t i) const
+        {
+            return data_[i];
+        }
+
+        T &
+        operator[](const std::size_t i)
+        {
+            return data_[i];
+        }
+
+        C &
+        data() noexcept
+        {
+            return data_;
+        }
+
+        C const &
+        data() const noexcept
+        {
+            return data_;
+        }
+
+      private:
+        // views like std::span can't be resized
+        void
+        resize(std::size_t const n)
+        {
+            if constexpr (requires { data_.resize(n); })
+            {
+                data_.resize(n);
+            }
+            else if (n != size())
+            {
+                throw std::length_error{"cannot resize the storage of this vector"};
+            }
+        }
+
+        template <typename U, typename X>
+        void
+        assign(vector<U, X> const &other)
+        {
+            if constexpr (std::ranges::contiguous_range<C>)
+            {
+                constexpr std::size_t alignment = simd::alignment_v<C>;
+
+                auto const out = std::ranges::data(data_);
+                if constexpr (is_fixed_storage_v<C>)
+                {
+                    simd::evaluate_fixed<C::extent, alignment>(out, other.data());
+                }
+                else if (other.size() >= parallel::threshold)
+                {
+                    parallel::evaluate<alignment>(out, other.data(), other.size(), parallel::default_pool());
+                }
+                else
+                {
+                    simd::evaluate<alignment>(out, other.data(), 0, other.size());
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < other.size(); ++i)
+                {
+                    data_[i] = static_cast<T>(other[i]);
+                }
+            }
+        }
+
+        C data_;
+    };
+
+    // vectors with cache line aligned storage
+    template <typename T>
+    using aligned_vector = vector<T, std::vector<T, aligned_allocator<T>>>;
+
+    // small vectors with a size known at compile time
+    template <typename T, std::size_t N>
+    using fixed_vector = vector<T, fixed_storage<T, N>>;
+
+    // A scalar operand is broadcast to every element.
+    template <typename S>
+    struct scalar
+    {
+        using value_type = S;
+
+        static constexpr bool vectorizable = simd::element<S>;
+
+        S
+        operator[](std::size_t const) const
+        {
+            return value;
+        }
+
+        template <std::size_t N>
+        auto
+        load(std::size_t const) const
+        {
+            return simd::broadcast<S, N>(value);
+        }
+
+        // a scalar has no size of its own; the vector operands determine the size of an expression
+        std::size_t
+        size() const noexcept
+        {
+            return 0;
+        }
+
+        detail::overlap
+        aliasing(void const *, void const *) const noexcept
+        {
+            return detail::overlap::none;
+        }
+
+        S value;
+    };
+
+    template <typename Op, typename... Es>
+    struct vector_expression;
+
+    // Scalars and nested expressions are created on the fly by the operators below, i.e. they are temporaries.
+    // Holding them by reference would dangle as soon as the full-expression ends (auto e = 2 * (a + b);).
+    // They are small, so they are copied. Only the containers holding the data (the leaves) are referenced;
+    // they have to outlive the expression.
+    template <typename E>
+    inline constexpr bool is_expression_v = false;
+
+    template <typename S>
+    inline constexpr bool is_expression_v<scalar<S>> = true;
+
+    template <typename Op, typename... Es>
+    inline constexpr bool is_expression_v<vector_expression<Op, Es...>> = true;
+
+    template <typename E>
+    using operand_storage_t = std::conditional_t<is_expression_v<E>, E, E const &>;
+
+    // Element-wise operation Op on the operands Es (containers, other expressions or scalars).
+    template <typename Op, typename... Es>
+    struct vector_expression
+    {
+        using value_type = decltype(Op{}(std::declval<typename Es::value_type>()...));
+
+        static constexpr bool vectorizable = (simd::evaluable<Es> && ...) && simd::element<value_type>;
+
+        vector_expression(Es const &...es) : operands_(es...)
+        {
+        }
+
+        // lazy evaluation: the operation only occurs when invoking the subscript operator
+        value_type
+        operator[](std::size_t const i) const
+        {
+            return std::apply([i](auto const &...es) { return Op{}(es[i]...); }, operands_);
+        }
+
+        // the same for N elements at once
+        template <std::size_t N>
+        simd::pack<value_type, N>
+        load(std::size_t const i) const
+        {
+            return std::apply(
+                [i](auto const &...es) {
+                    return simd::apply<value_type, N>(Op{}, simd::convert<value_type, N>(simd::load<N>(es, i))...);
+                },
+                operands_);
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return std::apply([](auto const &...es) { return std::max({es.size()...}); }, operands_);
+        }
+
+        // the worst overlap of any operand with the memory [first, last)
+        detail::overlap
+        aliasing(void const *const first, void const *const last) const
+        {
+            return std::apply([=](auto const &...es) { return std::max({detail::aliasing(es, first, last)...}); },
+                              operands_);
+        }
+
+      private:
+        std::tuple<operand_storage_t<Es>...> operands_;
+    };
+
+    template <typename L, typename R>
+    using vector_add = vector_expression<std::plus<>, L, R>;
+
+    template <typename L, typename R>
+    using vector_sub = vector_expression<std::minus<>, L, R>;
+
+    template <typename L, typename R>
+    using vector_mul = vector_expression<std::multiplies<>, L, R>;
+
+    template <typename L, typename R>
+    using vector_div = vector_expression<std::divides<>, L, R>;
+
+    template <typename S, typename R>
+    using vector_scalar_mul = vector_expression<std::multiplies<>, scalar<S>, R>;
+
+    // element-wise math functions, applied lane by lane in SIMD blocks
+
+    struct sqrt_op
+    {
+        template <simd::element T>
+        auto
+        operator()(T const x) const
+        {
+            return std::sqrt(x);
+        }
+    };
+
+    struct exp_op
+    {
+        template <simd::element T>
+        auto
+        operator()(T const x) const
+        {
+            return std::exp(x);
+        }
+    };
+
+    struct abs_op
+    {
+        template <simd::element T>
+        T
+        operator()(T const x) const
+        {
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                return x;
+            }
+            else
+            {
+                return static_cast<T>(std::abs(x));
+            }
+        }
+    };
+
+    struct fma_op
+    {
+        template <simd::element A, simd::element B, simd::element C>
+        auto
+        operator()(A const a, B const b, C const c) const
+        {
+            return std::fma(a, b, c);
+        }
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        inline constexpr bool is_vector_v = false;
+
+        template <typename T, typename C>
+        inline constexpr bool is_vector_v<vector<T, C>> = true;
+
+        // vectors take part with their container (or expression), everything else is a broadcast scalar
+        template <typename T, typename C>
+        C const &
+        operand(vector<T, C> const &v)
+        {
+            return v.data();
+        }
+
+        template <typename S>
+        scalar<S>
+        operand(S const &s)
+        {
+            return scalar<S>{s};
+        }
+
+        template <typename Op, typename... Es>
+        auto
+        make_expression(Es const &...es)
+        {
+            using node = vector_expression<Op, Es...>;
+
+            return vector<typename node::value_type, node>(node(es...));
+        }
+    } // namespace detail
+
+    // a vector (or expression), or an arithmetic scalar that is broadcast to every element
+    template <typename T>
+    concept vector_operand = detail::is_vector_v<T> || std::is_arithmetic_v<T>;
+
+    // at least one operand has to be a vector, the other one may be a scalar (on either side)
+    template <typename A, typename B>
+    concept vector_operands =
+        vector_operand<A> && vector_operand<B> && (detail::is_vector_v<A> || detail::is_vector_v<B>);
+
+    template <typename A, typename B>
+        requires vector_operands<A, B>
+    auto
+    operator+(A const &a, B const &b)
+    {
+        return detail::make_expression<std::plus<>>(detail::operand(a), detail::operand(b));
+    }
+
+    template <typename A, typename B>
+        requires vector_operands<A, B>
+    auto
+    operator-(A const &a, B const &b)
+    {
+        return detail::make_expression<std::minus<>>(detail::operand(a), detail::operand(b));
+    }
+
+    template <typename A, typename B>
+        requires vector_operands<A, B>
+    auto
+    operator*(A const &a, B const &b)
+    {
+        return detail::make_expression<std::multiplies<>>(detail::operand(a), detail::operand(b));
+    }
+
+    template <typename A, typename B>
+        requires vector_operands<A, B>
+    auto
+    operator/(A const &a, B const &b)
+    {
+        return detail::make_expression<std::divides<>>(detail::operand(a), detail::operand(b));
+    }
+
+    template <typename T, typename E>
+    auto
+    operator-(vector<T, E> const &v)
+    {
+        return detail::make_expression<std::negate<>>(v.data());
+    }
+
+    template <typename T, typename E>
+    auto
+    sqrt(vector<T, E> const &v)
+    {
+        return detail::make_expression<sqrt_op>(v.data());
+    }
+
+    template <typename T, typename E>
+    auto
+    exp(vector<T, E> const &v)
+    {
+        return detail::make_expression<exp_op>(v.data());
+    }
+
+    template <typename T, typename E>
+    auto
+    abs(vector<T, E> const &v)
+    {
+        return detail::make_expression<abs_op>(v.data());
+    }
+
+    // a * b + c rounded once
+    template <typename A, typename B, typename C>
+        requires(vector_operand<A> && vector_operand<B> && vector_operand<C> &&
+                 (detail::is_vector_v<A> || detail::is_vector_v<B> || detail::is_vector_v<C>))
+    auto
+    fma(A const &a, B const &b, C const &c)
+    {
+        return detail::make_expression<fma_op>(detail::operand(a), detail::operand(b), detail::operand(c));
+    }
+
+    // Reductions evaluate the whole expression in a single pass without materializing it:
+    // dot(a + b, c) never creates the vector a + b (nor a temporary for the products).
+
+    template <typename T, typename E>
+    T
+    sum(vector<T, E> const &v)
+    {
+        return simd::sum<T>(v.data(), v.size());
+    }
+
+    template <typename T, typename L, typename U, typename R>
+    auto
+    dot(vector<T, L> const &a, vector<U, R> const &b)
+    {
+        return sum(a * b);
+    }
+
+    template <typename T, typename E>
+    auto
+    norm(vector<T, E> const &v)
+    {
+        return std::sqrt(dot(v, v));
+    }
+} // namespace n717
+
+namespace n717b
+{
+    // Row-major matrices with the lazy evaluation of n717. Element-wise expressions are evaluated tile by tile,
+    // so that transposed operands, which are read column by column, stay in the cache. Products of two matrices
+    // are not element-wise; they are evaluated as a whole with a tiled GEMM.
+
+    namespace simd = n717::simd;
+
+    using n717::detail::aliasing;
+    using n717::detail::overlap;
+
+    template <typename T, typename A = std::allocator<T>>
+    struct dense_storage
+    {
+        using value_type = T;
+
+        dense_storage() = default;
+
+        dense_storage(std::size_t const rows, std::size_t const cols) : rows_(rows), cols_(cols), data_(rows * cols)
+        {
+        }
+
+        dense_storage(std::initializer_list<std::initializer_list<T>> l)
+            : rows_(l.size()), cols_(l.size() > 0 ? l.begin()->size() : 0)
+        {
+            data_.reserve(rows_ * cols_);
+            for (auto const &row : l)
+            {
+                if (row.size() != cols_)
+                {
+                    throw std::length_error{"all rows need the same number of columns"};
+                }
+                data_.insert(data_.end(), row);
+            }
+        }
+
+        std::size_t
+        rows() const noexcept
+        {
+            return rows_;
+        }
+
+        std::size_t
+        cols() const noexcept
+        {
+            return cols_;
+        }
+
+        void
+        resize(std::size_t const rows, std::size_t const cols)
+        {
+            rows_ = rows;
+            cols_ = cols;
+            data_.resize(rows * cols);
+        }
+
+        T const &
+        operator()(std::size_t const r, std::size_t const c) const noexcept
+        {
+            return data_[r * cols_ + c];
+        }
+
+        T &
+        operator()(std::size_t const r, std::size_t const c) noexcept
+        {
+            return data_[r * cols_ + c];
+        }
+
+        // all elements, row by row
+
+        std::size_t
+        size() const noexcept
+        {
+            return data_.size();
+        }
+
+        T *
+        data() noexcept
+        {
+            return data_.data();
+        }
+
+        T const *
+        data() const noexcept
+        {
+            return data_.data();
+        }
+
+        auto
+        begin() noexcept
+        {
+            return data_.begin();
+        }
+
+        auto
+        begin() const noexcept
+        {
+            return data_.begin();
+        }
+
+        auto
+        end() noexcept
+        {
+            return data_.end();
+        }
+
+        auto
+        end() const noexcept
+        {
+            return data_.end();
+        }
+
+      private:
+        std::size_t       rows_ = 0;
+        std::size_t       cols_ = 0;
+        std::vector<T, A> data_;
+    };
+
+    template <typename E>
+    inline constexpr bool is_dense_v = false;
+
+    template <typename T, typename A>
+    inline constexpr bool is_dense_v<dense_storage<T, A>> = true;
+
+    // a scalar operand is broadcast to every element
+    template <typename S>
+    struct scalar
+    {
+        using value_type = S;
+
+        static constexpr bool vectorizable = simd::element<S>;
+
+        S
+        operator()(std::size_t const, std::size_t const) const
+        {
+            return value;
+        }
+
+        template <std::size_t N>
+        auto
+        load(std::size_t const, std::size_t const) const
+        {
+            return simd::broadcast<S, N>(value);
+        }
+
+        // the matrix operands determine the shape of an expression
+        std::size_t
+        rows() const noexcept
+        {
+            return 0;
+        }
+
+        std::size_t
+        cols() const noexcept
+        {
+            return 0;
+        }
+
+        overlap
+        aliasing(void const *, void const *) const noexcept
+        {
+            return overlap::none;
+        }
+
+        S value;
+    };
+
+    template <typename Op, typename... Es>
+    struct matrix_expression;
+
+    template <typename E>
+    struct transposed;
+
+    template <typename L, typename R>
+    struct matrix_product;
+
+    // as in n717: the storage is referenced, the nodes created on the fly are copied
+    template <typename E>
+    inline constexpr bool is_expression_v = false;
+
+    template <typename S>
+    inline constexpr bool is_expression_v<scalar<S>> = true;
+
+    template <typename Op, typename... Es>
+    inline constexpr bool is_expression_v<matrix_expression<Op, Es...>> = true;
+
+    template <typename E>
+    inline constexpr bool is_expression_v<transposed<E>> = true;
+
+    template <typename L, typename R>
+    inline constexpr bool is_expression_v<matrix_product<L, R>> = true;
+
+    template <typename E>
+    using operand_storage_t = std::conditional_t<is_expression_v<E> || n717::is_expression_v<E>, E, E const &>;
+
+    template <typename E>
+    inline constexpr bool is_scalar_v = false;
+
+    template <typename S>
+    inline constexpr bool is_scalar_v<scalar<S>> = true;
+
+    template <typename E>
+    inline constexpr bool is_product_v = false;
+
+    template <typename L, typename R>
+    inline constexpr bool is_product_v<matrix_product<L, R>> = true;
+
+    // Element-wise nodes read their operands element by element, which would turn a product into one dot product
+    // per element. They hold a product as a matrix instead, evaluated up front with the tiled GEMM.
+    template <typename E>
+    using element_operand_t =
+        std::conditional_t<is_product_v<E>, dense_storage<typename E::value_type>, operand_storage_t<E>>;
+
+    namespace detail
+    {
+        template <typename E>
+        concept evaluable = (is_dense_v<E> && simd::element<typename E::value_type>) || requires {
+            requires E::vectorizable;
+        };
+
+        // N elements of row r, starting at column c
+        template <std::size_t N, typename E>
+        auto
+        load(E const &e, std::size_t const r, std::size_t const c)
+        {
+            if constexpr (is_dense_v<E>)
+            {
+                simd::pack<typename E::value_type, N> p;
+                std::memcpy(&p, &e(r, c), sizeof(p));
+                return p;
+            }
+            else
+            {
+                return e.template load<N>(r, c);
+            }
+        }
+
+        // evaluates the columns [first, last) of row r of e into out (the start of the row)
+        template <typename T, typename E>
+        void
+        evaluate_row(T *const out, E const &e, std::size_t const r, std::size_t const first, std::size_t const last)
+        {
+            std::size_t c = first;
+            if constexpr (simd::element<T> && evaluable<E>)
+            {
+                constexpr std::size_t N = simd::lanes<T>;
+
+                for (; c + N <= last; c += N)
+                {
+                    auto const p = simd::convert<T, N>(load<N>(e, r, c));
+                    std::memcpy(out + c, &p, sizeof(p));
+                }
+            }
+            for (; c < last; ++c)
+            {
+                out[c] = static_cast<T>(e(r, c));
+            }
+        }
+
+        inline constexpr std::size_t tile = 64;
+
+        // element-wise expressions, one tile of tile x tile elements after the other
+        template <typename T, typename A, typename E>
+        void
+        evaluate_blocked(dense_storage<T, A> &out, E const &e)
+        {
+            for (std::size_t r0 = 0; r0 < out.rows(); r0 += tile)
+            {
+                for (std::size_t c0 = 0; c0 < out.cols(); c0 += tile)
+                {
+                    auto const r1 = std::min(r0 + tile, out.rows());
+                    auto const c1 = std::min(c0 + tile, out.cols());
+                    for (std::size_t r = r0; r < r1; ++r)
+                    {
+                        evaluate_row(&out(r, 0), e, r, c0, c1);
+                    }
+                }
+            }
+        }
+
+        // operands of a product are evaluated first unless they are stored matrices already
+        template <typename E>
+        decltype(auto)
+        materialize(E const &e)
+        {
+            if constexpr (is_dense_v<E>)
+            {
+                return e;
+            }
+            else
+            {
+                dense_storage<typename E::value_type> result(e.rows(), e.cols());
+                if constexpr (requires { e.evaluate_into(result); })
+                {
+                    e.evaluate_into(result);
+                }
+                else
+                {
+                    evaluate_blocked(result, e);
+                }
+                return result;
+            }
+        }
+
+        // initializes an element_operand_t<E>
+        template <typename E>
+        decltype(auto)
+        element_operand(E const &e)
+        {
+            if constexpr (is_product_v<E>)
+            {
+                return materialize(e);
+            }
+            else
+            {
+                return e;
+            }
+        }
+    } // namespace detail
+
+    // element-wise operation Op on matrices (and scalars) of the same shape
+    template <typename Op, typename... Es>
+    struct matrix_expression
+    {
+        using value_type = decltype(Op{}(std::declval<typename Es::value_type>()...));
+
+        static constexpr bool vectorizable =
+            (detail::evaluable<std::remove_cvref_t<element_operand_t<Es>>> && ...) && simd::element<value_type>;
+
+        matrix_expression(Es const &...es) : operands_(detail::element_operand(es)...)
+        {
+            // scalars have no shape, they are broadcast
+            if (!((is_scalar_v<Es> || (es.rows() == rows() && es.cols() == cols())) && ...))
+            {
+                throw std::length_error{"matrix dimensions don't match"};
+            }
+        }
+
+        value_type
+        operator()(std::size_t const r, std::size_t const c) const
+        {
+            return std::apply([=](auto const &...es) { return Op{}(es(r, c)...); }, operands_);
+        }
+
+        template <std::size_t N>
+        simd::pack<value_type, N>
+        load(std::size_t const r, std::size_t const c) const
+        {
+            return std::apply(
+                [=](auto const &...es) {
+                    return simd::apply<value_type, N>(Op{},
+                                                      simd::convert<value_type, N>(detail::load<N>(es, r, c))...);
+                },
+                operands_);
+        }
+
+        std::size_t
+        rows() const noexcept
+        {
+            return std::apply([](auto const &...es) { return std::max({es.rows()...}); }, operands_);
+        }
+
+        std::size_t
+        cols() const noexcept
+        {
+            return std::apply([](auto const &...es) { return std::max({es.cols()...}); }, operands_);
+        }
+
+        overlap
+        aliasing(void const *const first, void const *const last) const
+        {
+            return std::apply([=](auto const &...es) { return std::max({n717b::aliasing(es, first, last)...}); },
+                              operands_);
+        }
+
+      private:
+        std::tuple<element_operand_t<Es>...> operands_;
+    };
+
+    // a view with rows and columns swapped
+    template <typename E>
+    struct transposed
+    {
+        using value_type = E::value_type;
+
+        static constexpr bool vectorizable = simd::element<value_type>;
+
+        transposed(E const &e) : e_(detail::element_operand(e))
+        {
+        }
+
+        value_type
+        operator()(std::size_t const r, std::size_t const c) const
+        {
+            return e_(c, r);
+        }
+
+        // a row of the view is a column of e: the elements are gathered one by one
+        template <std::size_t N>
+        simd::pack<value_type, N>
+        load(std::size_t const r, std::size_t const c) const
+        {
+            simd::pack<value_type, N> p;
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                p[k] = e_(c + k, r);
+            }
+            return p;
+        }
+
+        std::size_t
+        rows() const noexcept
+        {
+            return e_.cols();
+        }
+
+        std::size_t
+        cols() const noexcept
         {
-            apply_all(unit, std::make_index_sequence<length_v<TL>>{});
+            return e_.rows();
         }
-    };
 
-    void
-    upgrade_unit(game_unit &unit)
-    {
-        using upgrade_types = typelist<upgrade_defense, upgrade_attack>;
-        apply_functors<upgrade_types>{}(unit);
-    }
+        // element (r, c) is read at another position
+        overlap
+        aliasing(void const *const first, void const *const last) const
+        {
+            return n717b::aliasing(e_, first, last) == overlap::none ? overlap::none : overlap::partial;
+        }
 
-    // this doesn't work
-    // template <typename... Ts>
-    // struct transformer
-    // {
-    //     using input_types  = Ts...;
-    //     using output_types = std::add_const_t<Ts>...;
-    // };
+      private:
+        element_operand_t<E> e_;
+    };
 
-    template <typename... Ts>
-    struct transformer
+    // Matrix product. It is always evaluated as a whole with a tiled GEMM: assigned to a matrix, or up front as
+    // the operand of an element-wise expression (see element_operand_t). Reading single elements computes a dot
+    // product of a row and a column each.
+    template <typename L, typename R>
+    struct matrix_product
     {
-        using input_types  = typelist<Ts...>;
-        using output_types = typelist<std::add_const_t<Ts>...>;
-    };
+        using value_type = decltype(std::declval<typename L::value_type>() * std::declval<typename R::value_type>());
 
-    static_assert(std::is_same_v<transformer<int, double>::output_types, typelist<int const, double const>>);
-} // namespace n715
+        static constexpr bool vectorizable = false;
 
-// Expression templates
+        matrix_product(L const &l, R const &r) : lhv_(l), rhv_(r)
+        {
+            if (l.cols() != r.rows())
+            {
+                throw std::length_error{"matrix dimensions don't match"};
+            }
+        }
 
-namespace n716
-{
-    template <typename T>
-    struct vector
-    {
-        vector(std::size_t const n) : data_(n)
+        value_type
+        operator()(std::size_t const r, std::size_t const c) const
         {
+            value_type result{};
+            for (std::size_t k = 0; k < lhv_.cols(); ++k)
+            {
+                result += lhv_(r, k) * rhv_(k, c);
+            }
+            return result;
         }
 
-        vector(std::initializer_list<T> &&l) : data_(l)
+        std::size_t
+        rows() const noexcept
         {
+            return lhv_.rows();
         }
 
         std::size_t
-        size() const noexcept
+        cols() const noexcept
         {
-            return data_.size();
+            return rhv_.cols();
         }
 
-        T const &
-        operator[](const std::size_t i) const
+        overlap
+        aliasing(void const *const first, void const *const last) const
         {
-            return data_[i];
+            return std::max(n717b::aliasing(lhv_, first, last), n717b::aliasing(rhv_, first, last)) == overlap::none
+                       ? overlap::none
+                       : overlap::partial;
         }
 
-        T &
-        operator[](const std::size_t i)
+        // Tiles of tile x tile elements of a, b and out fit into the L1/L2 cache together. Within a tile the
+        // innermost loop runs along a row of b and out, which the compiler vectorizes.
+        template <typename T, typename A>
+        void
+        evaluate_into(dense_storage<T, A> &out) const
         {
-            return data_[i];
+            using detail::tile;
+
+            auto &&a = detail::materialize(lhv_);
+            auto &&b = detail::materialize(rhv_);
+
+            auto const n = a.rows();
+            auto const m = a.cols();
+            auto const p = b.cols();
+
+            std::ranges::fill(out, T{});
+            for (std::size_t i0 = 0; i0 < n; i0 += tile)
+            {
+                for (std::size_t k0 = 0; k0 < m; k0 += tile)
+                {
+                    for (std::size_t j0 = 0; j0 < p; j0 += tile)
+                    {
+                        auto const i1 = std::min(i0 + tile, n);
+                        auto const k1 = std::min(k0 + tile, m);
+                        auto const j1 = std::min(j0 + tile, p);
+                        for (std::size_t i = i0; i < i1; ++i)
+                        {
+                            T *const out_row = &out(i, 0);
+                            for (std::size_t k = k0; k < k1; ++k)
+                            {
+                                auto const  aik   = a(i, k);
+                                auto const *b_row = &b(k, 0);
+                                for (std::size_t j = j0; j < j1; ++j)
+                                {
+                                    out_row[j] += static_cast<T>(aik * b_row[j]);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
         }
 
       private:
-        std::vector<T> data_;
+        operand_storage_t<L> lhv_;
+        operand_storage_t<R> rhv_;
     };
 
-    template <typename T, typename U>
-    auto
-    operator+(vector<T> const &a, vector<U> const &b)
+    // Matrix-vector product, a node of an n717 vector expression. Element i reduces row i of the matrix with
+    // the vector; for a stored matrix (or a product, evaluated up front) that is an n717 dot product in SIMD blocks.
+    template <typename M, typename V>
+    struct matrix_vector_product
     {
-        using result_type = decltype(std::declval<T>() + std::declval<U>());
+        using value_type = decltype(std::declval<typename M::value_type>() * std::declval<typename V::value_type>());
 
-        vector<result_type> result(a.size());
+        static constexpr bool vectorizable = false;
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        matrix_vector_product(M const &m, V const &v) : m_(detail::element_operand(m)), v_(v)
         {
-            result[i] = a[i] + b[i];
+            if (m.cols() != v.size())
+            {
+                throw std::length_error{"matrix and vector dimensions don't match"};
+            }
         }
-        return result;
-    }
 
-    // dot product
-    template <typename T, typename U>
-    auto
-    operator*(vector<T> const &a, vector<U> const &b)
-    {
-        using result_type = decltype(std::declval<T>() * std::declval<U>());
+        value_type
+        operator[](std::size_t const i) const
+        {
+            if constexpr (is_dense_v<std::remove_cvref_t<element_operand_t<M>>>)
+            {
+                using row_type = std::span<typename M::value_type const>;
 
-        vector<result_type> result(a.size());
+                row_type const row{&m_(i, 0), m_.cols()};
+                return simd::sum<value_type>(n717::vector_expression<std::multiplies<>, row_type, V>(row, v_),
+                                             m_.cols());
+            }
+            else
+            {
+                value_type result{};
+                for (std::size_t k = 0; k < m_.cols(); ++k)
+                {
+                    result += m_(i, k) * v_[k];
+                }
+                return result;
+            }
+        }
 
-        for (std::size_t i = 0; i < a.size(); ++i)
+        std::size_t
+        size() const noexcept
         {
-            result[i] = a[i] * b[i];
+            return m_.rows();
         }
-        return result;
-    }
-
-    // scalar product
-    template <typename T, typename S>
-    auto
-    operator*(S const &s, vector<T> const &v)
-    {
-        using result_type = decltype(std::declval<S>() + std::declval<T>());
 
-        vector<result_type> result(v.size());
-
-        for (std::size_t i = 0; i < v.size(); ++i)
+        // every element reads the whole vector
+        overlap
+        aliasing(void const *const first, void const *const last) const
         {
-            result[i] = s * v[i];
+            return std::max(n717b::aliasing(m_, first, last), n717b::aliasing(v_, first, last)) == overlap::none
+                       ? overlap::none
+                       : overlap::partial;
         }
 
-        return result;
-    }
-} // namespace n716
+      private:
+        element_operand_t<M> m_;
+        operand_storage_t<V> v_;
+    };
 
-namespace n717
-{
     // T is the result type
-    template <typename T, typename C = std::vector<T>>
-    struct vector
+    template <typename T, typename C = dense_storage<T>>
+    struct matrix
     {
-        vector() = default;
+        matrix() = default;
 
-        vector(std::size_t const n) : data_(n)
+        matrix(std::size_t const rows, std::size_t const cols) : data_(rows, cols)
         {
         }
 
-        vector(std::initializer_list<T> &&l) : data_(l)
+        matrix(std::initializer_list<std::initializer_list<T>> l) : data_(l)
         {
         }
 
-        vector(C const &other) : data_(other)
+        matrix(C const &other) : data_(other)
         {
         }
 
         template <typename U, typename X>
-        vector(vector<U, X> const &other) : data_(other.size())
+        matrix(matrix<U, X> const &other) : data_(other.rows(), other.cols())
         {
-            for (std::size_t i = 0; i < other.size(); ++i)
-            {
-                data_[i] = static_cast<T>(other[i]);
-            }
+            assign(other);
         }
 
+        // as n717::vector::operator=: in place unless the expression reads elements we have already written
         template <typename U, typename X>
-        vector &
-        operator=(vector<U, X> const &other)
+        matrix &
+        operator=(matrix<U, X> const &other)
         {
-            data_.resize(other.size());
-            for (std::size_t i = 0; i < other.size(); ++i)
+            auto const first   = data_.data();
+            auto const overlap = n717b::aliasing(other.data(), first, first + data_.size());
+
+            if (overlap == overlap::none)
+            {
+                data_.resize(other.rows(), other.cols());
+                assign(other);
+            }
+            else if (overlap == overlap::same && other.rows() == rows() && other.cols() == cols())
             {
-                data_[i] = static_cast<T>(other[i]);
+                assign(other);
+            }
+            else
+            {
+                matrix result(other);
+                std::swap(data_, result.data_);
             }
 
             return *this;
         }
 
         std::size_t
-        size() const noexcept
+        rows() const noexcept
         {
-            return data_.size();
+            return data_.rows();
+        }
+
+        std::size_t
+        cols() const noexcept
+        {
+            return data_.cols();
         }
 
         T
-        operator[](const std::size_t i) const
+        operator()(std::size_t const r, std::size_t const c) const
         {
-            return data_[i];
+            return data_(r, c);
         }
 
         T &
-        operator[](const std::size_t i)
+        operator()(std::size_t const r, std::size_t const c)
         {
-            return data_[i];
+            return data_(r, c);
         }
 
         C &
@@ -1764,110 +5656,157 @@ namespace n717
         }
 
       private:
+        template <typename U, typename X>
+        void
+        assign(matrix<U, X> const &other)
+        {
+            if constexpr (requires { other.data().evaluate_into(data_); })
+            {
+                other.data().evaluate_into(data_);
+            }
+            else
+            {
+                detail::evaluate_blocked(data_, other.data());
+            }
+        }
+
         C data_;
     };
 
-    template <typename L, typename R>
-    struct vector_add
+    namespace detail
     {
-        vector_add(L const &a, R const &b) : lhv(a), rhv(b)
+        template <typename T>
+        inline constexpr bool is_matrix_v = false;
+
+        template <typename T, typename C>
+        inline constexpr bool is_matrix_v<matrix<T, C>> = true;
+
+        template <typename T>
+        inline constexpr bool is_vector_v = false;
+
+        template <typename T, typename C>
+        inline constexpr bool is_vector_v<n717::vector<T, C>> = true;
+
+        template <typename T, typename C>
+        C const &
+        operand(matrix<T, C> const &m)
         {
+            return m.data();
         }
 
-        // lazy evaluation: addition only occurs when invoking the subscript operator
-        auto
-        operator[](std::size_t const i) const
+        template <typename S>
+        scalar<S>
+        operand(S const &s)
         {
-            return lhv[i] + rhv[i];
+            return scalar<S>{s};
         }
 
-        std::size_t
-        size() const noexcept
+        template <typename Node, typename... Es>
+        auto
+        make_matrix(Es const &...es)
         {
-            return lhv.size();
+            return matrix<typename Node::value_type, Node>(Node(es...));
         }
+    } // namespace detail
 
-      private:
-        L const &lhv;
-        R const &rhv;
-    };
+    // matrix with matrix or scalar
+    template <typename A, typename B>
+    concept matrix_operands = (detail::is_matrix_v<A> || detail::is_matrix_v<B>) && !detail::is_vector_v<A> &&
+                              !detail::is_vector_v<B>;
 
-    template <typename L, typename R>
-    struct vector_mul
+    // matrix with scalar (on either side)
+    template <typename A, typename B>
+    concept matrix_scalar_operands = matrix_operands<A, B> && (detail::is_matrix_v<A> != detail::is_matrix_v<B>);
+
+    template <typename A, typename B>
+        requires matrix_operands<A, B>
+    auto
+    operator+(A const &a, B const &b)
     {
-        vector_mul(L const &a, R const &b) : lhv(a), rhv(b)
-        {
-        }
+        using L = decltype(detail::operand(a));
+        using R = decltype(detail::operand(b));
 
-        // lazy evaluation: multiplication only occurs when invoking the subscript operator
-        auto
-        operator[](std::size_t const i) const
-        {
-            return lhv[i] * rhv[i];
-        }
+        return detail::make_matrix<matrix_expression<std::plus<>, std::remove_cvref_t<L>, std::remove_cvref_t<R>>>(
+            detail::operand(a), detail::operand(b));
+    }
 
-        std::size_t
-        size() const noexcept
-        {
-            return lhv.size();
-        }
+    template <typename A, typename B>
+        requires matrix_operands<A, B>
+    auto
+    operator-(A const &a, B const &b)
+    {
+        using L = decltype(detail::operand(a));
+        using R = decltype(detail::operand(b));
 
-      private:
-        L const &lhv;
-        R const &rhv;
-    };
+        return detail::make_matrix<matrix_expression<std::minus<>, std::remove_cvref_t<L>, std::remove_cvref_t<R>>>(
+            detail::operand(a), detail::operand(b));
+    }
 
-    template <typename S, typename R>
-    struct vector_scalar_mul
+    template <typename A, typename B>
+        requires matrix_scalar_operands<A, B>
+    auto
+    operator*(A const &a, B const &b)
     {
-        vector_scalar_mul(S const &s, R const &b) : scalar(s), rhv(b)
-        {
-        }
+        using L = decltype(detail::operand(a));
+        using R = decltype(detail::operand(b));
 
-        // lazy evaluation: scalar multiplication only occurs when invoking the subscript operator
-        auto
-        operator[](std::size_t const i) const
-        {
-            return scalar * rhv[i];
-        }
+        return detail::make_matrix<
+            matrix_expression<std::multiplies<>, std::remove_cvref_t<L>, std::remove_cvref_t<R>>>(detail::operand(a),
+                                                                                                  detail::operand(b));
+    }
 
-        std::size_t
-        size() const noexcept
-        {
-            return rhv.size();
-        }
+    template <typename T, typename C, typename S>
+        requires(!detail::is_matrix_v<S> && !detail::is_vector_v<S>)
+    auto
+    operator/(matrix<T, C> const &m, S const &s)
+    {
+        return detail::make_matrix<matrix_expression<std::divides<>, C, scalar<S>>>(m.data(), scalar<S>{s});
+    }
 
-      private:
-        S const &scalar;
-        R const &rhv;
-    };
+    template <typename T, typename C>
+    auto
+    operator-(matrix<T, C> const &m)
+    {
+        return detail::make_matrix<matrix_expression<std::negate<>, C>>(m.data());
+    }
 
+    // element-wise product
     template <typename T, typename L, typename U, typename R>
     auto
-    operator+(vector<T, L> const &a, vector<U, R> const &b)
+    hadamard(matrix<T, L> const &a, matrix<U, R> const &b)
     {
-        using result_type = decltype(std::declval<T>() + std::declval<U>());
+        return detail::make_matrix<matrix_expression<std::multiplies<>, L, R>>(a.data(), b.data());
+    }
 
-        return vector<result_type, vector_add<L, R>>(vector_add<L, R>(a.data(), b.data()));
+    template <typename T, typename C>
+    auto
+    transpose(matrix<T, C> const &m)
+    {
+        return detail::make_matrix<transposed<C>>(m.data());
     }
 
     template <typename T, typename L, typename U, typename R>
     auto
-    operator*(vector<T, L> const &a, vector<U, R> const &b)
+    operator*(matrix<T, L> const &a, matrix<U, R> const &b)
     {
-        using result_type = decltype(std::declval<T>() * std::declval<U>());
-
-        return vector<result_type, vector_mul<L, R>>(vector_mul<L, R>(a.data(), b.data()));
+        return detail::make_matrix<matrix_product<L, R>>(a.data(), b.data());
     }
 
-    template <typename T, typename S, typename E>
+    template <typename T, typename C, typename U, typename X>
     auto
-    operator*(S const &a, vector<T, E> const &v)
+    operator*(matrix<T, C> const &m, n717::vector<U, X> const &v)
     {
-        using result_type = decltype(std::declval<T>() * std::declval<S>());
+        using node = matrix_vector_product<C, X>;
 
-        return vector<result_type, vector_scalar_mul<S, E>>(vector_scalar_mul<S, E>(a, v.data()));
+        return n717::vector<typename node::value_type, node>(node(m.data(), v.data()));
     }
+} // namespace n717b
+
+namespace n717
+{
+    // m * v is created on the fly as well, so n717 expressions (a * x + 1.0) have to copy it, too
+    template <typename M, typename V>
+    inline constexpr bool is_expression_v<n717b::matrix_vector_product<M, V>> = true;
 } // namespace n717
 
 int
@@ -1896,15 +5835,106 @@ main()
         fight({&k, &m}); // knight draws sword
                          // mage spells magic curse
 
-        knight_mage km = k + m;
-        km.attack();     // knight-mage draws magic sword
+        knight_mage km = k + m;
+        km.attack();     // knight-mage draws magic sword
+
+        attack a{42};
+        a = a + 2;
+
+        defence d{50};
+        increment(a);
+        increment(d);
+    }
+
+    {
+        std::println("\n====================== using namespace n701 =============================");
+
+        // dispatching per bucket instead of per unit
+
+        using namespace n701;
+
+        unit_buckets<knight, mage, knight_mage> army;
+        army.emplace<mage>();
+        army.emplace<knight>();
+        army.emplace<knight_mage>();
+        army.emplace<knight>();
+        fight(army); // knight draws sword
+                     // knight draws sword
+                     // mage spells magic curse
+                     // knight-mage draws magic sword
+
+        // same benchmark units behind a virtual interface and in buckets
+
+        struct archer : game_unit
+        {
+            int hits = 0;
+
+            void
+            attack() override
+            {
+                hits += 1;
+            }
+        };
+
+        struct lancer : game_unit
+        {
+            int hits = 0;
+
+            void
+            attack() override
+            {
+                hits += 2;
+            }
+        };
+
+        struct sorcerer : game_unit
+        {
+            int hits = 0;
+
+            void
+            attack() override
+            {
+                hits += 3;
+            }
+        };
+
+        constexpr size_t per_type = 1'000'000;
+
+        unit_buckets<archer, lancer, sorcerer> units;
+        units.reserve<archer>(per_type);
+        units.reserve<lancer>(per_type);
+        units.reserve<sorcerer>(per_type);
+        for (size_t i = 0; i < per_type; ++i)
+        {
+            units.emplace<archer>();
+            units.emplace<lancer>();
+            units.emplace<sorcerer>();
+        }
+
+        std::vector<game_unit *> mixed;
+        mixed.reserve(units.size());
+        units.for_each([&mixed](game_unit &unit) { mixed.push_back(&unit); });
+        std::ranges::shuffle(mixed, std::mt19937{42});
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < 10; ++frame)
+            {
+                f();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto virtual_ms = measure([&mixed]() { fight(mixed); });
+        auto bucket_ms  = measure([&units]() { fight(units); });
 
-        attack a{42};
-        a = a + 2;
+        long total = 0;
+        units.for_each([&total](auto const &unit) { total += unit.hits; });
 
-        defence d{50};
-        increment(a);
-        increment(d);
+        std::println("{} units, 10 frames", units.size());
+        std::println("virtual attack():    {:8.1f} ms", virtual_ms);
+        std::println("per-bucket attack(): {:8.1f} ms", bucket_ms);
+        std::println("hits: {}", total); // 120000000
     }
 
     // The Curiously Recurring Template Pattern
@@ -1966,6 +5996,123 @@ main()
         }
     }
 
+    {
+        std::println("\n====================== using namespace n704 =============================");
+
+        // contention: constructing/destroying instances from several threads
+
+        using namespace n704;
+
+        struct shared_counted : limited_instances<shared_counted, 10'000>
+        {
+        };
+
+        constexpr int threads    = 4;
+        constexpr int iterations = 1'000'000;
+
+        auto measure = [](auto make) {
+            auto const start = std::chrono::steady_clock::now();
+            {
+                std::vector<std::jthread> workers;
+                for (int t = 0; t < threads; ++t)
+                {
+                    workers.emplace_back([make]() {
+                        for (int i = 0; i < iterations; ++i)
+                        {
+                            [[maybe_unused]] auto instance = make();
+                        }
+                    });
+                }
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto shared_ms = measure([]() { return shared_counted{}; });
+        auto cached_ms = measure([]() { return arrow{}; });
+
+        std::println("single atomic counter: {:8.1f} ms", shared_ms);
+        std::println("thread-local tokens:   {:8.1f} ms", cached_ms);
+        std::println("live: {}, available tokens: {}", shared_counted::count.load(),
+                     arrow::available.load()); // live: 0, available tokens: 10000
+
+        // the limit still holds
+        try
+        {
+            std::vector<arrow> quiver(10'001); // will throw an exception
+        }
+        catch (std::exception &e)
+        {
+            std::println("{}", e.what()); // Too many instances
+        }
+    }
+
+    {
+        std::println("\n====================== using namespace n704 =============================");
+
+        // heap instances are served from preallocated pools
+
+        using namespace n704;
+
+        try
+        {
+            auto b1 = std::make_unique<book_of_magic>();
+            auto b2 = std::make_unique<book_of_magic>();
+            auto b3 = std::make_unique<book_of_magic>();
+            std::println("{} {} {}", static_cast<void *>(b1.get()), static_cast<void *>(b2.get()),
+                         static_cast<void *>(b3.get())); // adjacent slots
+            auto b4 = std::make_unique<book_of_magic>(); // will throw an exception, the limit is reached
+        }
+        catch (std::exception &e)
+        {
+            std::println("{}", e.what()); // Too many instances
+        }
+
+        try
+        {
+            book_of_magic b1;
+            auto          b2 = std::make_unique<book_of_magic>();
+            auto          b3 = std::make_unique<book_of_magic>();
+            auto          b4 = std::make_unique<book_of_magic>(); // will throw an exception, its slot is given back
+        }
+        catch (std::exception &e)
+        {
+            std::println("{}", e.what()); // Too many instances
+        }
+
+        struct plain_arrow
+        {
+            char tip[16];
+        };
+
+        constexpr int threads    = 4;
+        constexpr int iterations = 1'000'000;
+        constexpr int batch      = 16;
+
+        auto measure = [](auto make) {
+            auto const start = std::chrono::steady_clock::now();
+            {
+                std::vector<std::jthread> workers;
+                for (int t = 0; t < threads; ++t)
+                {
+                    workers.emplace_back([make]() {
+                        for (int i = 0; i < iterations; i += batch)
+                        {
+                            std::array<decltype(make()), batch> quiver;
+                            std::ranges::generate(quiver, make);
+                        }
+                    });
+                }
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto heap_ms = measure([]() { return std::make_unique<plain_arrow>(); });
+        auto pool_ms = measure([]() { return std::make_unique<arrow>(); });
+
+        std::println("global operator new: {:8.1f} ms", heap_ms);
+        std::println("instance pool:       {:8.1f} ms", pool_ms);
+    }
+
     // Adding functionality with CRTP
 
     {
@@ -2113,6 +6260,204 @@ main()
                                                // building destroyed
     }
 
+    {
+        std::println("\n====================== using namespace n709c ============================");
+
+        // benchmark: thread per task versus thread pool with work stealing
+
+        using namespace n709c;
+
+        constexpr int n = 10'000;
+
+        auto tasks_per_second = [](auto &&make_executor) {
+            std::atomic<int> done{0};
+            auto const       start = std::chrono::steady_clock::now();
+            {
+                auto e = make_executor();
+                for (int i = 0; i < n; ++i)
+                {
+                    e->execute([&done]() { done.fetch_add(1, std::memory_order_relaxed); });
+                }
+            } // waits for all tasks
+            std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+            return std::pair{done.load(), n / elapsed.count()};
+        };
+
+        auto [done1, rate1] = tasks_per_second([]() { return std::make_unique<thread_per_task_executor>(); });
+        auto [done2, rate2] = tasks_per_second([]() { return std::make_unique<executor>(); });
+
+        std::println("thread per task: {:12.0f} tasks/s ({} tasks)", rate1, done1);
+        std::println("thread pool:     {:12.0f} tasks/s ({} tasks)", rate2, done2);
+    }
+
+    {
+        std::println("\n====================== using namespace n709c ============================");
+
+        // small-buffer, move-only tasks
+
+        using namespace n709c;
+
+        auto b    = std::make_shared<building>();
+        auto task = [self = b]() {};
+
+        using task_type = executor::task_type;
+
+        std::println("sizeof(std::function):     {}", sizeof(std::function<void()>));
+        std::println("sizeof(task_type):         {}", sizeof(task_type));                          // 64
+        std::println("shared_ptr capture inline: {}", task_type::stores_inline<decltype(task)>()); // true
+
+        task_type t1 = std::move(task);
+        task_type t2 = std::move(t1); // moves the captured shared_ptr; no reference count bump
+        t2();
+        std::println("t1: {}, t2: {}", static_cast<bool>(t1), static_cast<bool>(t2)); // t1: false, t2: true
+
+        executor e;
+        e.execute([]() { return 42; }); // the result is discarded, as with std::function<void()>
+    }
+
+    {
+        std::println("\n====================== using namespace n709c ============================");
+
+        // batch submission and waiting for a subset of the tasks
+
+        using namespace n709c;
+
+        executor e;
+
+        std::vector<std::shared_ptr<building>> batch{std::make_shared<building>(), std::make_shared<building>()};
+        {
+            task_group upgrades{e};
+            for (auto &b : batch)
+            {
+                b->upgrade(upgrades);
+            }
+            upgrades.wait(); // only these two upgrades; the executor keeps running
+            std::println("batch upgraded");
+        }
+
+        task_group                    g{e};
+        std::vector<std::future<int>> results;
+        for (int i = 1; i <= 10; ++i)
+        {
+            results.push_back(g.run([i]() { return i * i; }));
+        }
+
+        int sum = 0;
+        for (auto &r : results)
+        {
+            sum += r.get();
+        }
+        std::println("sum of squares: {}", sum); // 385
+
+        std::atomic<int>                 counter{0};
+        std::vector<executor::task_type> tasks;
+        for (int i = 0; i < 1000; ++i)
+        {
+            tasks.emplace_back([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        std::vector<std::function<void()>> jobs(1000, [&counter]() { counter.fetch_add(1); });
+
+        g.run_bulk(std::move(tasks)); // one lock, one atomic update per counter; the tasks are moved
+        g.run_bulk(jobs);             // the jobs are copied
+        g.wait();
+        std::println("group finished, counter: {}", counter.load()); // 2000
+    }
+
+    {
+        std::println("\n====================== using namespace n709d ============================");
+
+        // coroutines: thousands of concurrent upgrades on a few threads
+
+        using namespace n709d;
+
+        n709c::executor e;
+        scheduler       s{e};
+
+        std::vector<std::unique_ptr<building>> buildings;
+        std::vector<task<>>                    upgrades;
+        for (int i = 0; i < 10'000; ++i)
+        {
+            buildings.push_back(std::make_unique<building>(s));
+            upgrades.push_back(buildings.back()->upgrade());
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        sync_wait_all(std::move(upgrades));
+        std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - start;
+
+        auto const operational = std::ranges::count_if(buildings, [](auto const &b) { return b->operational(); });
+
+        // each upgrade waits 250 ms; all of them together take only a little longer than that
+        std::println("{} buildings upgraded on {} threads in {:.0f} ms", operational, e.size(), elapsed.count());
+
+        auto answer = [](scheduler &s) -> task<int> {
+            co_await s.schedule();
+            co_return 42;
+        };
+        std::println("{}", sync_wait(answer(s))); // 42
+    }
+
+    {
+        std::println("\n====================== using namespace n709e ============================");
+
+        // benchmark: 1M task submissions capturing shared_from_this() versus intrusive_from_this()
+
+        using namespace n709e;
+
+        constexpr int n = 1'000'000;
+
+        auto measure = [](auto &&f) {
+            auto const start = std::chrono::steady_clock::now();
+            f();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto sb = std::make_shared<shared_building>();
+        auto ib = make_intrusive<building>();
+        auto lb = make_intrusive<local_building>();
+
+        auto shared_ms = measure([&] {
+            n709c::executor e;
+            for (int i = 0; i < n; ++i)
+            {
+                sb->upgrade(e);
+            }
+        });
+        auto intrusive_ms = measure([&] {
+            n709c::executor e;
+            for (int i = 0; i < n; ++i)
+            {
+                ib->upgrade(e);
+            }
+        });
+
+        std::println("executor, shared_ptr:              {:8.1f} ms ({} upgrades)", shared_ms, sb->upgrades());
+        std::println("executor, intrusive_ptr (atomic):  {:8.1f} ms ({} upgrades)", intrusive_ms, ib->upgrades());
+
+        // single-threaded scheduler: here the count does not have to be atomic
+        inline_scheduler s;
+
+        auto shared_local_ms = measure([&] {
+            for (int i = 0; i < n; ++i)
+            {
+                sb->upgrade(s);
+            }
+            s.run();
+        });
+        auto intrusive_local_ms = measure([&] {
+            for (int i = 0; i < n; ++i)
+            {
+                lb->upgrade(s);
+            }
+            s.run();
+        });
+
+        std::println("inline,   shared_ptr:              {:8.1f} ms", shared_local_ms);
+        std::println("inline,   intrusive_ptr (plain):   {:8.1f} ms ({} upgrades)", intrusive_local_ms, lb->upgrades());
+        std::println("sizeof(shared_ptr): {}, sizeof(intrusive_ptr): {}", sizeof(sb), sizeof(ib)); // 16, 8
+        std::println("use_count: {}", lb->use_count());                                            // 1
+    }
+
     // Mixins
 
     // The point of mixins is that they are supposed to add functionality to classes
@@ -2196,86 +6541,262 @@ main()
         }
     }
 
-    // Type erasure
+    // Type erasure
+
+    // The term type erasure describes a pattern in which type information is removed,
+    // allowing types that are not necessarily related to be treated in a generic way.
+
+    // True type erasure is achieved with templates!
+
+    {
+        std::println("\n====================== using namespace n712e ============================");
+
+        using namespace n712e;
+
+        knight k;
+        mage   m;
+
+        std::vector<mapping_void_ptr_fight_fn> units{
+            {&k, &fight_knight},
+            {&m, &fight_mage},
+        };
+
+        fight(units);
+    }
+
+    {
+        std::println("\n====================== using namespace n712a ============================");
+
+        using namespace n712a;
+
+        knight k;
+        mage   m;
+
+        knight_unit ku{k};
+        mage_unit   mu{m};
+
+        std::vector<game_unit *> v{&ku, &mu};
+
+        fight(v);
+    }
+
+    {
+        std::println("\n====================== using namespace n712b ============================");
+
+        using namespace n712b;
+
+        knight k;
+        mage   m;
+
+        game_unit_wrapper ku{k};
+        game_unit_wrapper mu{m};
+
+        std::vector<game_unit *> v{&ku, &mu};
+        fight(v);
+    }
+
+    {
+        std::println("\n====================== using namespace n712c ============================");
+
+        using namespace n712c;
+
+        knight k;
+        mage   m;
+
+        game g;
+        g.addUnit(k);
+        g.addUnit(m);
+
+        g.fight();
+    }
+
+    {
+        std::println("\n====================== using namespace n712d ============================");
+
+        using namespace n712d;
+
+        knight k;
+        mage   m;
+
+        std::vector<unit> v{unit(k), unit(m)};
+
+        fight(v);
+    }
+
+    {
+        std::println("\n====================== using namespace n712f ============================");
+
+        // small-buffer optimized type erasure with value semantics
+
+        using namespace n712f;
+
+        std::vector<unit> v{n712d::knight{}, n712d::mage{}}; // no heap allocation for the units
+        auto              w = v;                             // copies the units
+        fight(w);                                            // draw sword
+                                                             // spell magic curse
+
+        struct siege_engine
+        {
+            std::array<int, 64> ammunition{};
+
+            void
+            attack()
+            {
+                std::println("fire boulder");
+            }
+        };
+
+        static_assert(!unit::stores_inline<siege_engine>());
+        v.emplace_back(siege_engine{}); // falls back to the heap
+        fight(v);                       // draw sword
+                                        // spell magic curse
+                                        // fire boulder
+
+        unit engine = std::move(v.back()); // takes over the heap object, v.back() is empty now
+        unit empty  = v.back();            // copying an empty unit gives another empty unit
+        v.pop_back();
+        engine.attack();                   // fire boulder
+
+        // benchmark against n712d
 
-    // The term type erasure describes a pattern in which type information is removed,
-    // allowing types that are not necessarily related to be treated in a generic way.
+        struct archer
+        {
+            int hits = 0;
 
-    // True type erasure is achieved with templates!
+            void
+            attack()
+            {
+                hits += 1;
+            }
+        };
 
-    {
-        std::println("\n====================== using namespace n712e ============================");
+        struct lancer
+        {
+            int hits = 0;
 
-        using namespace n712e;
+            void
+            attack()
+            {
+                hits += 2;
+            }
+        };
 
-        knight k;
-        mage   m;
+        constexpr size_t count = 3'000'000;
 
-        std::vector<mapping_void_ptr_fight_fn> units{
-            {&k, &fight_knight},
-            {&m, &fight_mage},
+        std::vector<archer>      archers(count / 2);
+        std::vector<lancer>      lancers(count / 2);
+        std::vector<n712d::unit> erased;
+        std::vector<unit>        small;
+        erased.reserve(count);
+        small.reserve(count);
+        for (size_t i = 0; i < count / 2; ++i)
+        {
+            erased.emplace_back(archers[i]);
+            erased.emplace_back(lancers[i]);
+            small.emplace_back(archer{});
+            small.emplace_back(lancer{});
+        }
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < 10; ++frame)
+            {
+                f();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
         };
 
-        fight(units);
+        auto erased_ms = measure([&erased]() { n712d::fight(erased); });
+        auto small_ms  = measure([&small]() { fight(small); });
+
+        std::println("{} units, 10 frames", count);
+        std::println("shared_ptr + virtual:    {:8.1f} ms", erased_ms);
+        std::println("inline + function table: {:8.1f} ms", small_ms);
     }
 
     {
-        std::println("\n====================== using namespace n712a ============================");
+        std::println("\n====================== using namespace n712g ============================");
 
-        using namespace n712a;
+        // type erasure generated from a list of methods
 
-        knight k;
-        mage   m;
+        using namespace n712g;
 
-        knight_unit ku{k};
-        mage_unit   mu{m};
+        std::vector<unit> army{knight{}, mage{}};
+        fight(army);                               // draw sword
+                                                   // spell magic curse
 
-        std::vector<game_unit *> v{&ku, &mu};
+        for (auto &u : army)
+        {
+            u.call<upgrade>(3);
+        }
 
-        fight(v);
+        unit const &first = army.front();
+        std::println("{}", first.call<defense>()); // 13
+        // first.call<attack>();                   // error: attack is not const
+        static_assert(noexcept(first.call<defense>()));
+
+        auto copy = army;                          // copies the units
+        copy[1].call<upgrade>(1);
+        std::println("{} {}", army[1].call<defense>(), copy[1].call<defense>()); // 11 13
     }
 
     {
-        std::println("\n====================== using namespace n712b ============================");
-
-        using namespace n712b;
+        std::println("\n====================== using namespace n712h ============================");
 
-        knight k;
-        mage   m;
+        // non-owning type erasure
 
-        game_unit_wrapper ku{k};
-        game_unit_wrapper mu{m};
+        using namespace n712h;
 
-        std::vector<game_unit *> v{&ku, &mu};
-        fight(v);
-    }
+        n712d::knight k;
+        n712d::mage   m;
 
-    {
-        std::println("\n====================== using namespace n712c ============================");
+        std::vector<unit_ref> units{k, m, k};
+        int                   attacks = 0;
+        fight(units, [&attacks](std::size_t) { ++attacks; }); // draw sword
+                                                              // spell magic curse
+                                                              // draw sword
+        std::println("{}", attacks);                          // 3
 
-        using namespace n712c;
+        auto                 count_hit = [&attacks]() { return ++attacks; };
+        function_ref<void()> on_hit    = count_hit; // the int result is discarded
+        on_hit();
+        std::println("{}", attacks); // 4
 
-        knight k;
-        mage   m;
+        // benchmark against n712d
 
-        game g;
-        g.addUnit(k);
-        g.addUnit(m);
+        struct archer
+        {
+            int hits = 0;
 
-        g.fight();
-    }
+            void
+            attack()
+            {
+                hits += 1;
+            }
+        };
 
-    {
-        std::println("\n====================== using namespace n712d ============================");
+        constexpr size_t count = 3'000'000;
 
-        using namespace n712d;
+        std::vector<archer>      archers(count);
+        std::vector<n712d::unit> erased(archers.begin(), archers.end());
+        std::vector<unit_ref>    refs(archers.begin(), archers.end());
 
-        knight k;
-        mage   m;
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < 10; ++frame)
+            {
+                f();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
 
-        std::vector<unit> v{unit(k), unit(m)};
+        std::size_t last      = 0;
+        auto        erased_ms = measure([&erased]() { n712d::fight(erased); });
+        auto        refs_ms   = measure([&refs, &last]() { fight(refs, [&last](std::size_t i) { last = i; }); });
 
-        fight(v);
+        std::println("{} units, 10 frames", count);
+        std::println("shared_ptr + virtual:        {:8.1f} ms", erased_ms);
+        std::println("unit_ref (+ function_ref):   {:8.1f} ms", refs_ms);
     }
 
     {
@@ -2414,6 +6935,366 @@ main()
         std::println("{}", v5[2]);                   // 27
     }
 
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // the complete algebra
+
+        using namespace n717;
+
+        auto print = [](auto const &v) {
+            for (std::size_t i = 0; i < v.size(); ++i)
+            {
+                std::print("{} ", v[i]);
+            }
+            std::println();
+        };
+
+        vector<double> v1{1, 4, 9};
+        vector<double> v2{-1, 2, -3};
+
+        print(vector<double>(v1 - v2));            // 2 2 12
+        print(vector<double>(v1 / 2.0 + 1.0));     // 1.5 3 5.5
+        print(vector<double>(2.0 - -v2));          // 1 4 -1
+        print(vector<double>(sqrt(v1) * abs(v2))); // 1 4 9
+        print(vector<double>(fma(v1, v2, 10.0)));  // 9 18 -17
+        print(vector<double>(exp(v1 - v1)));       // 1 1 1
+
+        std::println("{}", sum(v1 + v2));          // 12
+        std::println("{}", dot(v1, v2));           // -20
+        std::println("{}", norm(v1 - v1 + v2));    // 3.7416573867739413
+    }
+
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // storing expressions
+
+        using namespace n717;
+
+        vector<double> a{1, 2, 3};
+        vector<double> b{4, 5, 6};
+
+        // 2.0 and the node of a + b are copied into e, only a and b are referenced
+        auto const e = 2.0 * (a + b);
+
+        vector<double> r(a.size());
+        auto const    *storage = r.data().data();
+        for (int frame = 0; frame < 3; ++frame)
+        {
+            r = e; // evaluated again with the current values of a and b, into the same storage
+            std::println("{} {} {}", r[0], r[1], r[2]);
+            a[0] += 1;
+        }
+        // 10 14 18
+        // 12 14 18
+        // 14 14 18
+        std::println("{}", storage == r.data().data()); // true
+    }
+
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // assigning expressions that read the destination
+
+        using namespace n717;
+
+        vector<double> a{1, 2, 3};
+        vector<double> b{4, 5, 6};
+
+        a = a + b; // in place: a[i] is only read to compute a[i]
+        a += b;
+        a *= 2.0;
+        std::println("{} {} {}", a[0], a[1], a[2]); // 18 24 30
+
+        // Overlapping views: evaluated in place, buffer[1] would be overwritten before it is read.
+        // So this is evaluated into a temporary.
+        std::vector<double>               buffer{1, 2, 3, 4};
+        vector<double, std::span<double>> dst(std::span{buffer}.subspan(1));
+        vector<double, std::span<double>> src(std::span{buffer}.first(3));
+        dst = src + 10.0;
+        std::println("{} {} {} {}", buffer[0], buffer[1], buffer[2], buffer[3]); // 1 11 12 13
+    }
+
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // aligned and fixed-size storage
+
+        using namespace n717;
+
+        auto alignment = [](void const *p) {
+            return std::size_t{1} << std::countr_zero(std::bit_cast<std::uintptr_t>(p));
+        };
+
+        n716::vector<double, n716::aligned_allocator<double>> x{1, 2, 3};
+        aligned_vector<double>                                y(1000);
+        std::println("{} {}", alignment(x.data()) >= 64, alignment(y.data().data()) >= 64); // true true
+
+        fixed_vector<float, 4> a{1, 2, 3, 4};
+        fixed_vector<float, 4> b{4, 3, 2, 1};
+        fixed_vector<float, 4> c = a + 2.0f * b; // one block with SSE or wider, no loop
+        std::println("{} {} {} {}", c[0], c[1], c[2], c[3]); // 9 8 7 6
+        std::println("{}", dot(a, b));                       // 20
+
+        fixed_vector<double, 3> p{1, 2, 2};
+        std::println("{}", norm(p));                         // 3
+        static_assert(sizeof(p) == 32);                      // padded to its alignment
+
+        // 4D updates: fixed size vs. dynamic size
+
+        constexpr int repeats = 10'000'000;
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            f();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        vector<float> da{1, 2, 3, 4};
+        vector<float> db{4, 3, 2, 1};
+        vector<float> dc(4);
+
+        auto fixed_ms = measure([&]() {
+            for (int i = 0; i < repeats; ++i)
+            {
+                c = a * b + 0.5f * c;
+            }
+        });
+        auto dynamic_ms = measure([&]() {
+            for (int i = 0; i < repeats; ++i)
+            {
+                dc = da * db + 0.5f * dc;
+            }
+        });
+
+        std::println("fixed_vector<float, 4>: {:8.1f} ms", fixed_ms);
+        std::println("vector<float>:          {:8.1f} ms", dynamic_ms);
+        std::println("{} {}", c[0], dc[0]); // 8 8
+    }
+
+    {
+        std::println("\n====================== using namespace n717b ============================");
+
+        // matrix expressions
+
+        using namespace n717b;
+
+        matrix<double> a{{1, 2, 3}, {4, 5, 6}};
+        matrix<double> b{{1, 0}, {0, 1}, {1, 1}};
+
+        auto print = [](auto const &m) {
+            for (std::size_t r = 0; r < m.rows(); ++r)
+            {
+                for (std::size_t c = 0; c < m.cols(); ++c)
+                {
+                    std::print("{} ", m(r, c));
+                }
+                std::println();
+            }
+        };
+
+        matrix<double> c = a * b;               // tiled GEMM
+        print(c);                               // 4 5
+                                                // 10 11
+        matrix<double> d = 2.0 * a - transpose(b) + 1.0;
+        print(d);                               // 2 5 6
+                                                // 9 10 12
+        c = transpose(c);                       // reads c at other positions: evaluated into a temporary
+        print(c);                               // 4 10
+                                                // 5 11
+
+        n717::vector<double> x{1, 1, 1};
+        n717::vector<double> y = a * x + 1.0;   // matrix-vector product in an n717 expression
+        std::println("{} {}", y[0], y[1]);      // 7 16
+
+        auto                 e = a * x + 1.0;   // the product node is copied into the expression, nothing dangles
+        n717::vector<double> z = e;
+        std::println("{} {}", z[0], z[1]);      // 7 16
+
+        matrix<double> f = a * b + c;           // the product is evaluated with the tiled GEMM first
+        print(f);                               // 8 15
+                                                // 15 22
+        try
+        {
+            matrix<double> g = a + b;           // will throw an exception
+        }
+        catch (std::exception &ex)
+        {
+            std::println("{}", ex.what());      // matrix dimensions don't match
+        }
+
+        // benchmarks
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            f();
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        constexpr std::size_t n = 512;
+
+        matrix<double> p(n, n);
+        matrix<double> q(n, n);
+        for (std::size_t r = 0; r < n; ++r)
+        {
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                p(r, k) = static_cast<double>((r + k) % 7);
+                q(r, k) = static_cast<double>((r * k) % 5);
+            }
+        }
+
+        matrix<double> naive(n, n);
+        auto           naive_ms = measure([&]() {
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                for (std::size_t j = 0; j < n; ++j)
+                {
+                    double sum = 0;
+                    for (std::size_t k = 0; k < n; ++k)
+                    {
+                        sum += p(i, k) * q(k, j);
+                    }
+                    naive(i, j) = sum;
+                }
+            }
+        });
+
+        matrix<double> tiled;
+        auto           tiled_ms = measure([&]() { tiled = p * q; });
+
+        std::println("{0}x{0} GEMM", n);
+        std::println("naive triple loop: {:8.1f} ms", naive_ms);
+        std::println("tiled GEMM node:   {:8.1f} ms", tiled_ms);
+        std::println("{}", naive(n - 1, n - 1) == tiled(n - 1, n - 1)); // true
+
+        matrix<double> s(n, n);
+        auto           transpose_naive_ms = measure([&]() {
+            for (int repeat = 0; repeat < 10; ++repeat)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    for (std::size_t j = 0; j < n; ++j)
+                    {
+                        s(i, j) = p(i, j) + q(j, i);
+                    }
+                }
+            }
+        });
+        auto           transpose_blocked_ms = measure([&]() {
+            for (int repeat = 0; repeat < 10; ++repeat)
+            {
+                s = p + transpose(q);
+            }
+        });
+
+        std::println("p + transpose(q), 10 times");
+        std::println("naive loop:        {:8.1f} ms", transpose_naive_ms);
+        std::println("blocked:           {:8.1f} ms", transpose_blocked_ms);
+    }
+
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // SIMD evaluation compared with eager evaluation (n716) and a hand-written loop
+
+        constexpr std::size_t size    = 1 << 20;
+        constexpr int         repeats = 50;
+
+        std::vector<double> a(size);
+        std::vector<double> b(size);
+        std::ranges::generate(a, [i = 0]() mutable { return 0.5 * i++; });
+        std::ranges::generate(b, [i = 0]() mutable { return 2.0 * i++; });
+
+        n716::vector<double> x1(size);
+        n716::vector<double> x2(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            x1[i] = a[i];
+            x2[i] = b[i];
+        }
+        n717::vector<double> y1(a);
+        n717::vector<double> y2(b);
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeats; ++i)
+            {
+                f();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        double checksum = 0;
+
+        auto eager_ms = measure([&]() {
+            n716::vector<double> r = x1 * x2 + x1 + 1.5 * x2;
+            checksum += r[size - 1];
+        });
+        auto lazy_ms = measure([&]() {
+            n717::vector<double> r = y1 * y2 + y1 + 1.5 * y2;
+            checksum += r[size - 1];
+        });
+        auto loop_ms = measure([&]() {
+            std::vector<double> r(size);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                r[i] = a[i] * b[i] + a[i] + 1.5 * b[i];
+            }
+            checksum += r[size - 1];
+        });
+
+        std::println("{} doubles, {} byte registers", size, n717::simd::register_bytes);
+        std::println("n716 (eager):        {:8.1f} ms", eager_ms);
+        std::println("n717 (lazy):         {:8.1f} ms", lazy_ms);
+        std::println("hand-written loop:   {:8.1f} ms", loop_ms);
+        std::println("{}", checksum);
+    }
+
+    {
+        std::println("\n====================== using namespace n717 =============================");
+
+        // throughput of a + b * c on 1, 2, 4, ... threads
+
+        constexpr std::size_t size    = std::size_t{1} << 23;
+        constexpr int         repeats = 10;
+
+        n717::vector<double> a(size);
+        n717::vector<double> b(size);
+        n717::vector<double> c(size);
+        std::vector<double>  r(size);
+        std::ranges::fill(a.data(), 1.0);
+        std::ranges::fill(b.data(), 2.0);
+        std::ranges::fill(c.data(), 3.0);
+
+        auto const expression = a + b * c;
+        auto const bytes      = 4.0 * sizeof(double) * size * repeats; // three reads and one write per element
+
+        std::vector<unsigned> thread_counts;
+        auto const            cores = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned threads = 1; threads < cores; threads *= 2)
+        {
+            thread_counts.push_back(threads);
+        }
+        thread_counts.push_back(cores);
+
+        for (auto const threads : thread_counts)
+        {
+            n709c::executor pool{threads};
+
+            auto const start = std::chrono::steady_clock::now();
+            for (int i = 0; i < repeats; ++i)
+            {
+                n717::parallel::evaluate(r.data(), expression.data(), size, pool);
+            }
+            std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+            std::println("{:3} threads: {:6.2f} GB/s", threads, bytes / elapsed.count() / 1e9);
+        }
+        std::println("{}", r[size - 1]); // 7
+    }
+
     {
         std::println("\n====================== ranges ===========================================");
 
@@ -2463,4 +7344,106 @@ main()
         upgrade_unit(u);
         std::println("{},{}", u.attack, u.defense); // 102,60
     }
+
+    {
+        std::println("\n====================== using namespace n715b ============================");
+
+        // closed set of units in a std::variant
+
+        using namespace n715b;
+
+        unit_set_t<typelist<n712d::knight, n712d::mage>> army;
+        army.emplace<n712d::knight>();
+        army.push_back(n712d::mage{});
+        fight(army); // draw sword
+                     // spell magic curse
+
+        // benchmark against type erasure (n712d)
+
+        struct archer
+        {
+            int hits = 0;
+
+            void
+            attack()
+            {
+                hits += 1;
+            }
+        };
+
+        struct lancer
+        {
+            int hits = 0;
+
+            void
+            attack()
+            {
+                hits += 2;
+            }
+        };
+
+        struct sorcerer
+        {
+            int hits = 0;
+
+            void
+            attack()
+            {
+                hits += 3;
+            }
+        };
+
+        constexpr size_t count = 3'000'000;
+
+        std::mt19937                       engine{42};
+        std::uniform_int_distribution<int> pick{0, 2};
+
+        unit_set<archer, lancer, sorcerer> units;
+        units.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            switch (pick(engine))
+            {
+            case 0:
+                units.emplace<archer>();
+                break;
+            case 1:
+                units.emplace<lancer>();
+                break;
+            default:
+                units.emplace<sorcerer>();
+                break;
+            }
+        }
+
+        // n712d::unit wraps its objects by reference, so they have to live somewhere else
+        std::vector<archer>      archers(count / 3);
+        std::vector<lancer>      lancers(count / 3);
+        std::vector<sorcerer>    sorcerers(count / 3);
+        std::vector<n712d::unit> erased;
+        erased.reserve(count);
+        for (size_t i = 0; i < count / 3; ++i)
+        {
+            erased.emplace_back(archers[i]);
+            erased.emplace_back(lancers[i]);
+            erased.emplace_back(sorcerers[i]);
+        }
+        std::ranges::shuffle(erased, engine);
+
+        auto measure = [](auto f) {
+            auto const start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < 10; ++frame)
+            {
+                f();
+            }
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        auto erased_ms  = measure([&erased]() { n712d::fight(erased); });
+        auto variant_ms = measure([&units]() { fight(units); });
+
+        std::println("{} units, 10 frames", count);
+        std::println("type erasure (shared_ptr): {:8.1f} ms", erased_ms);
+        std::println("unit_set (std::variant):   {:8.1f} ms", variant_ms);
+    }
 }
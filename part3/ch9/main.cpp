@@ -1,25 +1,41 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <format>
+#include <functional>
 #include <iostream>
+#include <latch>
+#include <limits>
+#include <list>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <print>
 #include <ranges>
+#include <set>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
 namespace n901
 {
-    int
+    // constexpr so that it can be used in compile-time evaluated pipelines (see n908);
+    // i * i <= number is the same bound as i <= sqrt(number) without calling std::sqrt
+    constexpr int
     sum_proper_divisors(int const number)
     {
         int result = 1;
 
-        for (int i = 2; i <= std::sqrt(number); ++i)
+        for (int i = 2; i * i <= number; ++i)
         {
             if (number % i == 0)
             {
@@ -30,7 +46,7 @@ namespace n901
         return result;
     }
 
-    bool
+    constexpr bool
     is_abundant(int const number)
     {
         return sum_proper_divisors(number) > number;
@@ -67,6 +83,8 @@ namespace n902
         using value_type     = typename std::ranges::range_value_t<R>;
         using reference_type = typename std::ranges::range_reference_t<R>;
 
+        step_iterator() = default;
+
         constexpr step_iterator(base start, base end, std::ranges::range_difference_t<R> step)
             : pos_{start}, end_{end}, step_{step}
         {
@@ -99,6 +117,13 @@ namespace n902
             return s.is_at_end(*this);
         }
 
+        // needed for forward iterators (multi-pass, e.g. splitting the range into chunks)
+        constexpr bool
+        operator==(step_iterator const &other) const
+        {
+            return pos_ == other.pos_;
+        }
+
         constexpr base const
         value() const
         {
@@ -106,9 +131,9 @@ namespace n902
         }
 
       private:
-        base                               pos_;
-        base                               end_;
-        std::ranges::range_difference_t<R> step_;
+        base                               pos_{};
+        base                               end_{};
+        std::ranges::range_difference_t<R> step_ = 1;
     };
 
     template <typename R>
@@ -123,7 +148,7 @@ namespace n902
     {
       private:
         R                                  base_;
-        std::ranges::range_difference_t<R> step_;
+        std::ranges::range_difference_t<R> step_ = 1;
 
       public:
         step_view() = default;
@@ -182,7 +207,7 @@ namespace n902
             requires std::ranges::sized_range<R const>
         {
             auto d = std::ranges::size(base_);
-            return step_ == 1 ? d : static_cast<int>((d + 1) / step_);
+            return (d + step_ - 1) / step_; // rounding up: the first element is always taken
         }
 
         constexpr auto
@@ -190,7 +215,7 @@ namespace n902
             requires std::ranges::sized_range<R>
         {
             auto d = std::ranges::size(base_);
-            return step_ == 1 ? d : static_cast<int>((d + 1) / step_);
+            return (d + step_ - 1) / step_; // rounding up: the first element is always taken
         }
     };
 
@@ -200,7 +225,7 @@ namespace n902
     namespace details
     {
         using test_range_t = std::ranges::views::all_t<std::vector<int>>;
-        static_assert(std::input_iterator<step_iterator<test_range_t>>);
+        static_assert(std::forward_iterator<step_iterator<test_range_t>>);
         static_assert(std::sentinel_for<step_sentinel<test_range_t>, step_iterator<test_range_t>>);
 
         struct step_view_fn_closure
@@ -277,6 +302,8 @@ namespace n903
         using value_type     = typename std::ranges::range_value_t<R>;
         using reference_type = typename std::ranges::range_reference_t<R>;
 
+        replicate_iterator() = default;
+
         constexpr replicate_iterator(base start, std::ranges::range_difference_t<R> count) : pos_{start}, count_{count}
         {
         }
@@ -284,17 +311,9 @@ namespace n903
         constexpr replicate_iterator
         operator++(int)
         {
-            if (step_ == count_)
-            {
-                step_ = 1;
-                pos_++;
-            }
-            else
-            {
-                step_++;
-            }
-
-            return pos_;
+            auto ret = *this;
+            ++*this;
+            return ret;
         }
 
         constexpr replicate_iterator &
@@ -325,6 +344,12 @@ namespace n903
             return s.is_at_end(*this);
         }
 
+        constexpr bool
+        operator==(replicate_iterator const &other) const
+        {
+            return pos_ == other.pos_ && step_ == other.step_;
+        }
+
         constexpr base const
         value() const
         {
@@ -332,9 +357,9 @@ namespace n903
         }
 
       private:
-        base                               pos_;
-        std::ranges::range_difference_t<R> count_;
-        std::ranges::range_difference_t<R> step_ = 1;
+        base                               pos_{};
+        std::ranges::range_difference_t<R> count_ = 1;
+        std::ranges::range_difference_t<R> step_  = 1;
     };
 
     template <typename R>
@@ -349,7 +374,7 @@ namespace n903
     {
       private:
         R                                  base_;
-        std::ranges::range_difference_t<R> count_;
+        std::ranges::range_difference_t<R> count_ = 1;
 
       public:
         replicate_view() = default;
@@ -424,7 +449,7 @@ namespace n903
     namespace details
     {
         using test_range_t = std::ranges::views::all_t<std::vector<int>>;
-        static_assert(std::input_iterator<replicate_iterator<test_range_t>>);
+        static_assert(std::forward_iterator<replicate_iterator<test_range_t>>);
         static_assert(std::sentinel_for<replicate_sentinel<test_range_t>, replicate_iterator<test_range_t>>);
 
         struct replicate_view_fn_closure
@@ -472,6 +497,848 @@ namespace n903
     }
 } // namespace n903
 
+namespace n904
+{
+    // Fused reductions: sum, count, min/max and mean are computed in a single pass directly over any
+    // input range (e.g. an istream_view) - no intermediate container, constant memory.
+
+    // Kahan (compensated) summation keeps the rounding error of long floating-point sums bounded.
+    template <typename T>
+    struct kahan_accumulator
+    {
+        constexpr void
+        add(T const value)
+        {
+            T const y     = value - compensation_;
+            T const t     = sum_ + y;
+            compensation_ = (t - sum_) - y;
+            sum_          = t;
+        }
+
+        constexpr void
+        merge(kahan_accumulator const &other)
+        {
+            add(other.sum_);
+            add(-other.compensation_);
+        }
+
+        constexpr T
+        value() const
+        {
+            return sum_;
+        }
+
+      private:
+        T sum_{};
+        T compensation_{};
+    };
+
+    template <typename T>
+    struct statistics
+    {
+        std::size_t          count = 0;
+        kahan_accumulator<T> total;
+        T                    min = std::numeric_limits<T>::max();
+        T                    max = std::numeric_limits<T>::lowest();
+
+        constexpr void
+        add(T const value)
+        {
+            ++count;
+            total.add(value);
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        // combines partial results (e.g. of sub-ranges reduced in parallel)
+        constexpr void
+        merge(statistics const &other)
+        {
+            count += other.count;
+            total.merge(other.total);
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        constexpr T
+        sum() const
+        {
+            return total.value();
+        }
+
+        constexpr T
+        mean() const
+        {
+            return count == 0 ? T{} : total.value() / static_cast<T>(count);
+        }
+    };
+
+    // all statistics in one pass
+    template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+    constexpr statistics<T>
+    reduce(R &&r)
+    {
+        statistics<T> result;
+        for (auto &&value : r)
+        {
+            result.add(static_cast<T>(value));
+        }
+        return result;
+    }
+
+    template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+    constexpr T
+    sum(R &&r, T init = T{})
+    {
+        for (auto &&value : r)
+        {
+            init += value;
+        }
+        return init;
+    }
+
+    template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+    constexpr T
+    kahan_sum(R &&r)
+    {
+        kahan_accumulator<T> acc;
+        for (auto &&value : r)
+        {
+            acc.add(static_cast<T>(value));
+        }
+        return acc.value();
+    }
+
+    template <std::ranges::input_range R>
+    constexpr std::size_t
+    count(R &&r)
+    {
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            return static_cast<std::size_t>(std::ranges::size(r));
+        }
+        else
+        {
+            std::size_t n = 0;
+            for (auto it = std::ranges::begin(r); it != std::ranges::end(r); ++it)
+            {
+                ++n;
+            }
+            return n;
+        }
+    }
+
+    // empty optional for an empty range
+    template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+    constexpr std::optional<std::pair<T, T>>
+    min_max(R &&r)
+    {
+        auto s = reduce<R, T>(std::forward<R>(r));
+        if (s.count == 0)
+        {
+            return std::nullopt;
+        }
+        return std::pair{s.min, s.max};
+    }
+
+    template <std::ranges::input_range R, typename T = std::ranges::range_value_t<R>>
+    constexpr T
+    mean(R &&r)
+    {
+        return reduce<R, T>(std::forward<R>(r)).mean();
+    }
+
+    // Contiguous sources can be split into sub-ranges that are reduced on separate threads;
+    // the partial results are merged afterwards in order.
+    template <std::ranges::contiguous_range R, typename T = std::ranges::range_value_t<R>>
+        requires std::ranges::sized_range<R>
+    statistics<T>
+    parallel_reduce(R &&r, std::size_t parts = std::thread::hardware_concurrency())
+    {
+        constexpr std::size_t min_chunk = 4096; // below that spawning threads does not pay off
+
+        std::span const data{std::ranges::data(r), std::ranges::size(r)};
+
+        parts = std::clamp<std::size_t>(parts, 1, std::max<std::size_t>(1, data.size() / min_chunk));
+        if (parts == 1)
+        {
+            return reduce<decltype(data) const &, T>(data);
+        }
+
+        std::vector<statistics<T>> partials(parts);
+        std::vector<std::thread>   threads;
+        threads.reserve(parts - 1);
+
+        auto const chunk = data.size() / parts;
+        auto const slice = [&](std::size_t const i) {
+            auto const first = i * chunk;
+            return data.subspan(first, i + 1 == parts ? data.size() - first : chunk);
+        };
+
+        for (std::size_t i = 1; i < parts; ++i)
+        {
+            threads.emplace_back([&, i]() { partials[i] = reduce<decltype(slice(i)), T>(slice(i)); });
+        }
+        partials[0] = reduce<decltype(slice(0)), T>(slice(0)); // the calling thread does its share
+
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+
+        statistics<T> result;
+        for (auto const &p : partials)
+        {
+            result.merge(p);
+        }
+        return result;
+    }
+} // namespace n904
+
+namespace n905
+{
+    // Structure of arrays (SoA): instead of a vector of records, every data member lives in its own
+    // contiguous vector (column). The columns are generated from a list of member pointers, which is
+    // as close as we get to reflection. A filter on one field then only touches that one column.
+
+    namespace details
+    {
+        template <typename M>
+        struct member_pointer_traits;
+
+        template <typename C, typename M>
+        struct member_pointer_traits<M C::*>
+        {
+            using class_type  = C;
+            using member_type = M;
+        };
+
+        template <auto Member>
+        using member_t = typename member_pointer_traits<decltype(Member)>::member_type;
+
+        template <auto A, auto B>
+        constexpr bool
+        same_member()
+        {
+            if constexpr (std::is_same_v<decltype(A), decltype(B)>)
+            {
+                return A == B;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    } // namespace details
+
+    template <typename T, auto... Members>
+        requires(std::is_same_v<typename details::member_pointer_traits<decltype(Members)>::class_type, T> && ...)
+    struct soa_vector
+    {
+        using value_type = T;
+
+        soa_vector() = default;
+
+        soa_vector(std::initializer_list<T> l)
+        {
+            reserve(l.size());
+            for (auto const &t : l)
+            {
+                push_back(t);
+            }
+        }
+
+        template <std::ranges::input_range R>
+            requires std::convertible_to<std::ranges::range_reference_t<R>, T const &>
+        explicit soa_vector(R &&r)
+        {
+            if constexpr (std::ranges::sized_range<R>)
+            {
+                reserve(std::ranges::size(r));
+            }
+            for (T const &t : r)
+            {
+                push_back(t);
+            }
+        }
+
+        void
+        push_back(T const &t)
+        {
+            push_back_impl(t, std::index_sequence_for<decltype(Members)...>{});
+        }
+
+        void
+        reserve(std::size_t const n)
+        {
+            std::apply([n](auto &...column) { (column.reserve(n), ...); }, columns_);
+        }
+
+        void
+        clear() noexcept
+        {
+            std::apply([](auto &...column) { (column.clear(), ...); }, columns_);
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return std::get<0>(columns_).size();
+        }
+
+        bool
+        empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        // reassembles the record at position i
+        T
+        operator[](std::size_t const i) const
+        {
+            return record_impl(i, std::index_sequence_for<decltype(Members)...>{});
+        }
+
+        // the projection: a contiguous column
+        template <auto Member>
+        std::span<details::member_t<Member>>
+        column() noexcept
+        {
+            return std::get<index_of<Member>()>(columns_);
+        }
+
+        template <auto Member>
+        std::span<details::member_t<Member> const>
+        column() const noexcept
+        {
+            return std::get<index_of<Member>()>(columns_);
+        }
+
+        // records as a (lazy) random access range
+        auto
+        records() const &
+        {
+            return std::views::iota(std::size_t{0}, size()) |
+                   std::views::transform([this](std::size_t const i) { return (*this)[i]; });
+        }
+
+        void records() const && = delete; // the view would dangle
+
+        // Keeps the records whose Member satisfies the predicate. Only the Member column is scanned;
+        // the other columns are touched for the matching rows only.
+        template <auto Member, typename Pred>
+        soa_vector
+        filter(Pred pred) const
+        {
+            soa_vector result;
+            auto const selected = column<Member>();
+            for (std::size_t i = 0; i < selected.size(); ++i)
+            {
+                if (std::invoke(pred, selected[i]))
+                {
+                    result.push_back_row(*this, i, std::index_sequence_for<decltype(Members)...>{});
+                }
+            }
+            return result;
+        }
+
+      private:
+        std::tuple<std::vector<details::member_t<Members>>...> columns_;
+
+        template <auto Member>
+        static constexpr std::size_t
+        index_of()
+        {
+            constexpr std::array<bool, sizeof...(Members)> matches{details::same_member<Member, Members>()...};
+            constexpr auto index = std::ranges::find(matches, true) - matches.begin();
+            static_assert(index < sizeof...(Members), "member is not a column of this soa_vector");
+            return index;
+        }
+
+        template <std::size_t... I>
+        void
+        push_back_impl(T const &t, std::index_sequence<I...>)
+        {
+            (std::get<I>(columns_).push_back(t.*Members), ...);
+        }
+
+        template <std::size_t... I>
+        void
+        push_back_row(soa_vector const &other, std::size_t const row, std::index_sequence<I...>)
+        {
+            (std::get<I>(columns_).push_back(std::get<I>(other.columns_)[row]), ...);
+        }
+
+        template <std::size_t... I>
+        T
+        record_impl(std::size_t const i, std::index_sequence<I...>) const
+        {
+            T t{};
+            ((t.*Members = std::get<I>(columns_)[i]), ...);
+            return t;
+        }
+    };
+} // namespace n905
+
+namespace n906
+{
+    // Parallel range algorithms for sized multi-pass ranges (std::vector, iota | transform, step_view,
+    // replicate_view, ...). The range is split into sub-ranges which are processed on a thread pool.
+
+    struct thread_pool
+    {
+        explicit thread_pool(std::size_t const threads = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            for (std::size_t i = 0; i < threads; ++i)
+            {
+                workers_.emplace_back([this]() { work(); });
+            }
+        }
+
+        thread_pool(thread_pool const &)            = delete;
+        thread_pool &operator=(thread_pool const &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock{mutex_};
+                done_ = true;
+            }
+            ready_.notify_all();
+            for (auto &t : workers_)
+            {
+                t.join();
+            }
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return workers_.size();
+        }
+
+        // runs f(0), ..., f(n - 1) on the pool and waits until all of them have finished
+        template <typename F>
+        void
+        run(std::size_t const n, F &&f)
+        {
+            std::latch finished{static_cast<std::ptrdiff_t>(n)};
+            {
+                std::lock_guard lock{mutex_};
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    tasks_.emplace_back([&f, &finished, i]() {
+                        f(i);
+                        finished.count_down();
+                    });
+                }
+            }
+            ready_.notify_all();
+            finished.wait();
+        }
+
+      private:
+        void
+        work()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock{mutex_};
+                    ready_.wait(lock, [this]() { return done_ || !tasks_.empty(); });
+                    if (tasks_.empty())
+                    {
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread>          workers_;
+        std::deque<std::function<void()>> tasks_;
+        std::mutex                        mutex_;
+        std::condition_variable           ready_;
+        bool                              done_ = false;
+    };
+
+    inline thread_pool &
+    default_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    template <typename R>
+    concept splittable_range = std::ranges::forward_range<R> && std::ranges::sized_range<R>;
+
+    namespace details
+    {
+        template <typename It>
+        struct chunk
+        {
+            It          first;
+            std::size_t count;
+        };
+
+        // Splits r into at most parts sub-ranges of (almost) equal length. For random access ranges
+        // advancing is O(1), otherwise the iterators are walked once.
+        template <splittable_range R>
+        auto
+        split(R &r, std::size_t const parts)
+        {
+            auto const n     = static_cast<std::size_t>(std::ranges::size(r));
+            auto const count = std::clamp<std::size_t>(parts, 1, std::max<std::size_t>(1, n));
+
+            std::vector<chunk<std::ranges::iterator_t<R>>> chunks;
+            chunks.reserve(count);
+
+            auto it = std::ranges::begin(r);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                auto const length = n / count + (i < n % count ? 1 : 0);
+                chunks.push_back({it, length});
+                if (i + 1 < count)
+                {
+                    it = std::ranges::next(it, static_cast<std::ranges::range_difference_t<R>>(length));
+                }
+            }
+
+            return chunks;
+        }
+
+        template <typename Chunk, typename F>
+        void
+        for_each_in(Chunk const &c, F &&f)
+        {
+            auto it = c.first;
+            for (std::size_t k = 0; k < c.count; ++k, ++it)
+            {
+                f(*it);
+            }
+        }
+    } // namespace details
+
+    template <splittable_range R, typename F>
+    void
+    for_each(thread_pool &pool, R &&r, F f)
+    {
+        auto const chunks = details::split(r, pool.size());
+        pool.run(chunks.size(), [&](std::size_t const i) { details::for_each_in(chunks[i], f); });
+    }
+
+    // Reduce must be associative; the partial results are combined in order.
+    template <splittable_range R, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce(thread_pool &pool, R &&r, T init, Reduce reduce, Transform transform)
+    {
+        auto const chunks = details::split(r, pool.size());
+
+        std::vector<std::optional<T>> partials(chunks.size());
+        pool.run(chunks.size(), [&](std::size_t const i) {
+            details::for_each_in(chunks[i], [&](auto &&value) {
+                auto &&t    = transform(std::forward<decltype(value)>(value));
+                partials[i] = partials[i] ? reduce(std::move(*partials[i]), t) : T(t);
+            });
+        });
+
+        for (auto &p : partials)
+        {
+            if (p)
+            {
+                init = reduce(std::move(init), std::move(*p));
+            }
+        }
+        return init;
+    }
+
+    // Stream compaction in two passes: every sub-range first counts its matches, an exclusive prefix
+    // sum over the counts gives each sub-range its output offset, then all sub-ranges write their
+    // matches in parallel. The relative order of the elements is preserved.
+    template <splittable_range R, std::random_access_iterator O, typename Pred>
+    O
+    copy_if(thread_pool &pool, R &&r, O out, Pred pred)
+    {
+        auto const chunks = details::split(r, pool.size());
+
+        std::vector<std::size_t> counts(chunks.size());
+        pool.run(chunks.size(), [&](std::size_t const i) {
+            details::for_each_in(chunks[i], [&](auto &&value) { counts[i] += pred(value) ? 1 : 0; });
+        });
+
+        std::vector<std::size_t> offsets(chunks.size());
+        std::exclusive_scan(counts.begin(), counts.end(), offsets.begin(), std::size_t{0});
+
+        pool.run(chunks.size(), [&](std::size_t const i) {
+            auto dest = out + static_cast<std::iter_difference_t<O>>(offsets[i]);
+            details::for_each_in(chunks[i], [&](auto &&value) {
+                if (pred(value))
+                {
+                    *dest++ = std::forward<decltype(value)>(value);
+                }
+            });
+        });
+
+        return out + static_cast<std::iter_difference_t<O>>(offsets.back() + counts.back());
+    }
+
+    template <splittable_range R, typename F>
+    void
+    for_each(R &&r, F f)
+    {
+        for_each(default_pool(), std::forward<R>(r), std::move(f));
+    }
+
+    template <splittable_range R, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce(R &&r, T init, Reduce reduce, Transform transform)
+    {
+        return transform_reduce(default_pool(), std::forward<R>(r), std::move(init), std::move(reduce),
+                                std::move(transform));
+    }
+
+    template <splittable_range R, std::random_access_iterator O, typename Pred>
+    O
+    copy_if(R &&r, O out, Pred pred)
+    {
+        return copy_if(default_pool(), std::forward<R>(r), out, std::move(pred));
+    }
+} // namespace n906
+
+namespace n907
+{
+    // Materializing a range into a container.
+    //
+    // Sized ranges reserve exactly once. Unsized ranges (e.g. after a filter) are first collected by a
+    // chunked builder whose chunks grow geometrically; elements are never moved while collecting, and
+    // they are moved once into the container which is then reserved exactly, too.
+
+    template <typename T>
+    struct chunked_builder
+    {
+        static constexpr std::size_t first_chunk = 64;
+
+        void
+        push_back(T value)
+        {
+            if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity())
+            {
+                auto const capacity = chunks_.empty() ? first_chunk : 2 * chunks_.back().capacity();
+                chunks_.emplace_back().reserve(capacity);
+            }
+            chunks_.back().push_back(std::move(value));
+            ++size_;
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return size_;
+        }
+
+        template <typename C>
+        void
+        move_into(C &c) &&
+        {
+            for (auto &chunk : chunks_)
+            {
+                std::ranges::move(chunk, std::back_inserter(c));
+            }
+            chunks_.clear();
+            size_ = 0;
+        }
+
+      private:
+        std::vector<std::vector<T>> chunks_;
+        std::size_t                 size_ = 0;
+    };
+
+    namespace details
+    {
+        template <typename C>
+        concept reservable_container = requires(C &c, std::size_t const n) {
+            c.reserve(n);
+            c.capacity();
+        };
+
+        template <typename C, typename T>
+        concept back_insertable = requires(C &c, T &&t) { c.push_back(std::forward<T>(t)); };
+
+        template <typename C, std::ranges::input_range R>
+        C
+        to_impl(R &&r)
+        {
+            using value_type = typename C::value_type;
+
+            C c;
+
+            if constexpr (!reservable_container<C> || !back_insertable<C, value_type>)
+            {
+                for (auto &&value : r)
+                {
+                    c.insert(c.end(), std::forward<decltype(value)>(value));
+                }
+            }
+            else if constexpr (std::ranges::sized_range<R>)
+            {
+                c.reserve(static_cast<std::size_t>(std::ranges::size(r)));
+                for (auto &&value : r)
+                {
+                    c.push_back(std::forward<decltype(value)>(value));
+                }
+            }
+            else
+            {
+                chunked_builder<value_type> builder;
+                for (auto &&value : r)
+                {
+                    builder.push_back(std::forward<decltype(value)>(value));
+                }
+                c.reserve(builder.size());
+                std::move(builder).move_into(c);
+            }
+
+            return c;
+        }
+
+        template <typename C>
+        struct to_fn_closure
+        {
+            template <std::ranges::input_range R>
+            friend C
+            operator|(R &&r, to_fn_closure)
+            {
+                return to_impl<C>(std::forward<R>(r));
+            }
+        };
+
+        template <template <typename...> typename C>
+        struct to_template_fn_closure
+        {
+            template <std::ranges::input_range R>
+            friend auto
+            operator|(R &&r, to_template_fn_closure)
+            {
+                return to_impl<C<std::ranges::range_value_t<R>>>(std::forward<R>(r));
+            }
+        };
+    } // namespace details
+
+    // to<std::vector<int>>(r), r | to<std::vector<int>>()
+    template <typename C, std::ranges::input_range R>
+    C
+    to(R &&r)
+    {
+        return details::to_impl<C>(std::forward<R>(r));
+    }
+
+    template <typename C>
+    details::to_fn_closure<C>
+    to()
+    {
+        return {};
+    }
+
+    // to<std::vector>(r), r | to<std::vector>(): element type deduced from the range
+    template <template <typename...> typename C, std::ranges::input_range R>
+    auto
+    to(R &&r)
+    {
+        return details::to_impl<C<std::ranges::range_value_t<R>>>(std::forward<R>(r));
+    }
+
+    template <template <typename...> typename C>
+    details::to_template_fn_closure<C>
+    to()
+    {
+        return {};
+    }
+} // namespace n907
+
+namespace n908
+{
+    // Compile-time evaluated range pipelines.
+    //
+    // Views (including n902::step_view and n903::replicate_view) are literal types with constexpr
+    // members, so a whole pipeline can be evaluated in a constant expression. to_array<N> materializes
+    // the first N elements into a std::array, which then is baked into the binary.
+
+    template <std::size_t N, std::ranges::input_range R>
+    constexpr auto
+    to_array(R &&r)
+    {
+        std::array<std::ranges::range_value_t<R>, N> result{};
+
+        auto       it   = std::ranges::begin(r);
+        auto const last = std::ranges::end(r);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (it == last)
+            {
+                // in a constant expression this is a compile-time error
+                throw std::length_error{"to_array: range has fewer than N elements"};
+            }
+
+            result[i] = *it;
+
+            // no increment past the N-th element (e.g. a filter would search for the next match)
+            if (i + 1 < N)
+            {
+                ++it;
+            }
+        }
+
+        return result;
+    }
+
+    namespace details
+    {
+        template <std::size_t N>
+        struct to_array_fn_closure
+        {
+            template <std::ranges::input_range R>
+            friend constexpr auto
+            operator|(R &&r, to_array_fn_closure)
+            {
+                return to_array<N>(std::forward<R>(r));
+            }
+        };
+    } // namespace details
+
+    template <std::size_t N>
+    constexpr details::to_array_fn_closure<N>
+    to_array()
+    {
+        return {};
+    }
+
+    // lookup tables computed at compile time
+
+    inline constexpr auto abundant_numbers =
+        std::views::iota(1) | std::views::filter(n901::is_abundant) | to_array<16>();
+
+    static_assert(abundant_numbers.front() == 12);
+    static_assert(abundant_numbers.back() == 78);
+
+    inline constexpr auto stepped_indices = std::views::iota(0, 64) | n902::views::step(8) | to_array<8>();
+
+    static_assert(stepped_indices[1] == 8);
+    static_assert(stepped_indices[7] == 56);
+
+    inline constexpr auto replicated_indices = std::views::iota(0, 4) | n903::views::replicate(3) | to_array<12>();
+
+    static_assert(replicated_indices[2] == 0);
+    static_assert(replicated_indices[3] == 1);
+    static_assert(replicated_indices[11] == 3);
+
+    static_assert(std::ranges::size(std::views::iota(1, 10) | n902::views::step(4)) == 3);
+    static_assert(std::ranges::size(std::views::iota(1, 5) | n903::views::replicate(2)) == 8);
+} // namespace n908
+
 struct Item
 {
     int         id;
@@ -1221,4 +2088,238 @@ main()
             std::print("{} ", i);
         }
     }
+
+    {
+        std::println("\n====================== using namespace n904 =============================");
+
+        // fused accumulate: parse and reduce in one pass, without the prices vector
+
+        auto text   = "19.99 7.50 49.19 20 12.34";
+        auto stream = std::istringstream{text};
+
+        auto stats = n904::reduce(std::ranges::istream_view<double>(stream));
+
+        std::println("count: {}", stats.count); // 5
+        std::println("total: {}", stats.sum()); // 109.02
+        std::println("min:   {}", stats.min);   // 7.5
+        std::println("max:   {}", stats.max);   // 49.19
+        std::println("mean:  {}", stats.mean());
+
+        stream = std::istringstream{text};
+        std::println("total: {}", n904::sum(std::ranges::istream_view<double>(stream)));
+
+        auto v = std::views::iota(1, 101) | std::views::filter(n901::is_abundant);
+        std::println("abundant numbers up to 100: {}", n904::count(v)); // 22
+        if (auto mm = n904::min_max(v))
+        {
+            std::println("first: {}, last: {}", mm->first, mm->second); // first: 12, last: 100
+        }
+    }
+
+    {
+        std::println("\n====================== using namespace n904 =============================");
+
+        // compensated and parallel partial sums over a contiguous source
+
+        std::vector<double> ledger(1'000'000, 0.1);
+
+        std::println("naive: {:.10f}", n904::sum(ledger));       // 100000.0000013329
+        std::println("kahan: {:.10f}", n904::kahan_sum(ledger)); // 100000.0000000000
+
+        auto stats = n904::parallel_reduce(ledger, 4);
+        std::println("parallel: {:.10f} ({} entries)", stats.sum(), stats.count);
+    }
+
+    {
+        std::println("\n====================== using namespace n905 =============================");
+
+        // structure of arrays generated from the Item aggregate
+
+        using items_t = n905::soa_vector<Item, &Item::id, &Item::name, &Item::price>;
+
+        items_t items{{1, "pen", 5.49}, {2, "ruler", 3.99}, {3, "pensil case", 12.50}};
+
+        // the projection is a contiguous column; no Item is dragged through the cache
+        std::vector<std::string> names;
+        std::ranges::copy_if(items.column<&Item::name>(),                             //
+                             std::back_inserter(names),                               //
+                             [](std::string const &name) { return name[0] == 'p'; }); //
+
+        for (auto const &name : names)
+        {
+            std::println("{}", name); // pen
+                                      // pensil case
+        }
+
+        std::println();
+
+        // filter on one field, get whole records back
+        auto expensive = items.filter<&Item::price>([](double const price) { return price > 5.0; });
+
+        for (Item const &item : expensive.records())
+        {
+            // id: 1, name: pen, price: 5.49
+            // id: 3, name: pensil case, price: 12.5
+            std::println("id: {}, name: {}, price: {}", item.id, item.name, item.price);
+        }
+    }
+
+    {
+        std::println("\n====================== using namespace n905 =============================");
+
+        // benchmark: AoS std::vector<Item> versus SoA columns
+
+        using items_t = n905::soa_vector<Item, &Item::id, &Item::name, &Item::price>;
+
+        constexpr int                  n = 500'000;
+        std::array<std::string, 4> const pool{"pen", "ruler", "pensil case", "notebook"};
+
+        std::vector<Item> aos;
+        aos.reserve(n);
+        for (int i = 0; i < n; ++i)
+        {
+            aos.push_back({i, pool[i % pool.size()], (i % 1000) / 10.0});
+        }
+        items_t soa{aos};
+
+        auto measure = [](auto &&f) {
+            auto const start  = std::chrono::steady_clock::now();
+            auto const result = f();
+            auto const stop   = std::chrono::steady_clock::now();
+            return std::pair{result, std::chrono::duration<double, std::milli>(stop - start).count()};
+        };
+
+        auto const expensive = [](double const price) { return price > 50.0; };
+
+        auto [aos_total, aos_ms] = measure([&] {
+            return n904::sum(aos | std::views::transform(&Item::price) | std::views::filter(expensive));
+        });
+        auto [soa_total, soa_ms] =
+            measure([&] { return n904::sum(soa.column<&Item::price>() | std::views::filter(expensive)); });
+
+        std::println("sum of prices > 50   AoS: {:8.3f} ms, SoA: {:8.3f} ms ({} == {})", aos_ms, soa_ms, aos_total,
+                     soa_total);
+
+        auto const starts_with_p = [](std::string const &name) { return name[0] == 'p'; };
+
+        auto [aos_count, aos_count_ms] =
+            measure([&] { return std::ranges::count_if(aos, starts_with_p, &Item::name); });
+        auto [soa_count, soa_count_ms] =
+            measure([&] { return std::ranges::count_if(soa.column<&Item::name>(), starts_with_p); });
+
+        std::println("names starting w/ p  AoS: {:8.3f} ms, SoA: {:8.3f} ms ({} == {})", aos_count_ms, soa_count_ms,
+                     aos_count, soa_count);
+    }
+
+    {
+        std::println("\n====================== using namespace n906 =============================");
+
+        // parallel algorithms over the custom views
+
+        n906::thread_pool pool{4};
+
+        std::atomic<int> total{0};
+        n906::for_each(pool, std::views::iota(1, 10) | n902::views::step(4), [&total](int const n) { total += n; });
+        std::println("sum of step(4): {}", total.load()); // 15 [= 1 + 5 + 9]
+
+        auto squares = n906::transform_reduce(pool, std::views::iota(1, 5) | n903::views::replicate(2), 0,
+                                              std::plus<>{}, [](int const n) { return n * n; });
+        std::println("sum of replicated squares: {}", squares); // 60 [= 2 * (1 + 4 + 9 + 16)]
+
+        auto const l_odd   = [](int const n) { return n % 2 == 1; };
+        auto const times_3 = [](int const n) { return n * 3; };
+        auto const r       = std::views::iota(1, 20) | n902::views::step(2) | std::views::transform(times_3);
+
+        std::vector<int> o(std::ranges::size(r));
+        o.erase(n906::copy_if(pool, r, o.begin(), l_odd), o.end());
+
+        for (auto v : o)
+        {
+            std::print("{} ", v); // 3 9 15 21 27 33 39 45 51 57
+        }
+        std::println();
+    }
+
+    {
+        std::println("\n====================== using namespace n906 =============================");
+
+        // order preserving compaction of a large range
+
+        auto const       is_abundant = [](int const n) { return n901::is_abundant(n); };
+        std::vector<int> numbers(200'000);
+        std::iota(numbers.begin(), numbers.end(), 1);
+
+        std::vector<int> expected;
+        std::ranges::copy_if(numbers, std::back_inserter(expected), is_abundant);
+
+        std::vector<int> actual(numbers.size());
+        actual.erase(n906::copy_if(numbers, actual.begin(), is_abundant), actual.end());
+
+        std::println("abundant numbers: {} (sequential: {}, same order: {})", actual.size(), expected.size(),
+                     actual == expected);
+    }
+
+    {
+        std::println("\n====================== using namespace n907 =============================");
+
+        // materializing without std::back_inserter
+
+        auto l_odd = [](int const n) { return n % 2 == 1; };
+
+        std::vector<int> v{1, 1, 2, 3, 5, 8, 13};
+
+        auto o1 = v | std::views::filter(l_odd) | n907::to<std::vector>();   // unsized: chunked builder
+        auto o2 = n907::to<std::vector<long>>(std::views::iota(1, 10));      // sized: exact reserve
+        auto o3 = v | std::views::filter(l_odd) | n907::to<std::set<int>>(); // no reserve at all
+        auto o4 = n907::to<std::list>(v | std::views::take(3));
+
+        std::println("{} (capacity {})", o1, o1.capacity()); // [1, 1, 3, 5, 13] (capacity 5)
+        std::println("{} (capacity {})", o2, o2.capacity()); // [1, 2, 3, 4, 5, 6, 7, 8, 9] (capacity 9)
+        std::println("{}", o3);                              // {1, 3, 5, 13}
+        std::println("{}", o4);                              // [1, 1, 2]
+    }
+
+    {
+        std::println("\n====================== using namespace n907 =============================");
+
+        // benchmark: std::back_inserter versus to<std::vector>
+
+        auto const is_even = [](int const n) { return n % 2 == 0; };
+        auto const numbers = std::views::iota(0, 4'000'000);
+
+        auto measure = [](auto &&f) {
+            auto const start  = std::chrono::steady_clock::now();
+            auto const result = f();
+            auto const stop   = std::chrono::steady_clock::now();
+            return std::pair{result.size(), std::chrono::duration<double, std::milli>(stop - start).count()};
+        };
+
+        auto [n1, inserter_ms] = measure([&] {
+            std::vector<int> o;
+            std::ranges::copy_if(numbers, std::back_inserter(o), is_even);
+            return o;
+        });
+        auto [n2, to_ms]    = measure([&] { return numbers | std::views::filter(is_even) | n907::to<std::vector>(); });
+        auto [n3, sized_ms] = measure([&] { return numbers | n907::to<std::vector>(); });
+
+        std::println("filtered, back_inserter: {:8.3f} ms ({} elements)", inserter_ms, n1);
+        std::println("filtered, to<vector>:    {:8.3f} ms ({} elements)", to_ms, n2);
+        std::println("sized,    to<vector>:    {:8.3f} ms ({} elements)", sized_ms, n3);
+    }
+
+    {
+        std::println("\n====================== using namespace n908 =============================");
+
+        // tables computed at compile time; nothing is evaluated at startup
+
+        using namespace n908;
+
+        std::println("abundant numbers:   {}", abundant_numbers);   // [12, 18, 20, 24, ..., 78]
+        std::println("stepped indices:    {}", stepped_indices);    // [0, 8, 16, 24, 32, 40, 48, 56]
+        std::println("replicated indices: {}", replicated_indices); // [0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3]
+
+        constexpr auto odd_squares = std::views::iota(1) | std::views::filter([](int const n) { return n % 2 == 1; }) |
+                                     std::views::transform([](int const n) { return n * n; }) | to_array<5>();
+        static_assert(odd_squares == std::array{1, 9, 25, 49, 81});
+    }
 }